@@ -0,0 +1,54 @@
+// 由 lexspec 根据词法规格生成，请勿手动修改
+#ifndef KEYWORD_TABLE_HPP
+#define KEYWORD_TABLE_HPP
+
+#include "keywords.hpp"
+
+constexpr const char* KEYWORD_TABLE_WORDS[16] = {
+    "",
+    "",
+    "void",
+    "float",
+    "int",
+    "",
+    "input",
+    "else",
+    "",
+    "",
+    "while",
+    "",
+    "return",
+    "print",
+    "",
+    "if",
+};
+
+constexpr const char* KEYWORD_TABLE_TOKENS[16] = {
+    "",
+    "",
+    "VOID",
+    "FLOAT",
+    "INT",
+    "",
+    "INPUT",
+    "ELSE",
+    "",
+    "",
+    "WHILE",
+    "",
+    "RETURN",
+    "PRINT",
+    "",
+    "IF",
+};
+
+constexpr KeywordTable KEYWORD_TABLE = {
+    16,
+    1,
+    6,
+    "ID",
+    KEYWORD_TABLE_WORDS,
+    KEYWORD_TABLE_TOKENS,
+};
+
+#endif
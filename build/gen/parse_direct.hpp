@@ -0,0 +1,2516 @@
+// 由 parsegen 根据文法生成的直接编码SLR(1)分析器，请勿手动修改
+#ifndef DirectParser_HPP
+#define DirectParser_HPP
+
+#include <cstdint>
+#include <vector>
+#include "parserule.hpp"
+#include "token.hpp"
+
+struct DirectParser {
+    // 生成时文法文本的哈希，与 LRParser::grammarHash 相同时符号和产生式编号才一致
+    static constexpr uint64_t GRAMMAR_HASH = 0x8c38cc00c64829d3ull;
+    static constexpr int TERMINAL_COUNT = 23;
+    static constexpr int EOF_KIND = 4;
+
+    // Decls -> ε
+    template <typename Value, typename Actions>
+    static bool reduce1(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[1], values.data() + values.size());
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 0:
+            states.push_back(1);
+            return true;
+        case 76:
+            states.push_back(79);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Decls -> Decls Decl SCO
+    template <typename Value, typename Actions>
+    static bool reduce2(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[2], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 0:
+            states.push_back(1);
+            return true;
+        case 76:
+            states.push_back(79);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Decl -> Type ID
+    template <typename Value, typename Actions>
+    static bool reduce3(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[3], values.data() + values.size() - 2);
+        states.resize(states.size() - 2);
+        values.resize(values.size() - 2);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+        case 79:
+            states.push_back(2);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Decl -> Type ID LBK NUM RBK
+    template <typename Value, typename Actions>
+    static bool reduce4(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[4], values.data() + values.size() - 5);
+        states.resize(states.size() - 5);
+        values.resize(values.size() - 5);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+        case 79:
+            states.push_back(2);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Decl -> Type ID LPA Params RPA LBR Decls Stmts RBR
+    template <typename Value, typename Actions>
+    static bool reduce5(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[5], values.data() + values.size() - 9);
+        states.resize(states.size() - 9);
+        values.resize(values.size() - 9);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+        case 79:
+            states.push_back(2);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Type -> INT
+    template <typename Value, typename Actions>
+    static bool reduce6(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[6], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+        case 79:
+            states.push_back(11);
+            return true;
+        case 56:
+            states.push_back(69);
+            return true;
+        case 81:
+            states.push_back(84);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Type -> FLOAT
+    template <typename Value, typename Actions>
+    static bool reduce7(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[7], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+        case 79:
+            states.push_back(11);
+            return true;
+        case 56:
+            states.push_back(69);
+            return true;
+        case 81:
+            states.push_back(84);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Type -> VOID
+    template <typename Value, typename Actions>
+    static bool reduce8(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[8], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+        case 79:
+            states.push_back(11);
+            return true;
+        case 56:
+            states.push_back(69);
+            return true;
+        case 81:
+            states.push_back(84);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Params -> ε
+    template <typename Value, typename Actions>
+    static bool reduce9(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[9], values.data() + values.size());
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 41:
+            states.push_back(56);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Params -> Params Param SCO
+    template <typename Value, typename Actions>
+    static bool reduce10(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[10], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 41:
+            states.push_back(56);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Param -> Type ID
+    template <typename Value, typename Actions>
+    static bool reduce11(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[11], values.data() + values.size() - 2);
+        states.resize(states.size() - 2);
+        values.resize(values.size() - 2);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 56:
+            states.push_back(67);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Param -> Type ID LBK RBK
+    template <typename Value, typename Actions>
+    static bool reduce12(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[12], values.data() + values.size() - 4);
+        states.resize(states.size() - 4);
+        values.resize(values.size() - 4);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 56:
+            states.push_back(67);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Param -> Type ID LPA Type RPA
+    template <typename Value, typename Actions>
+    static bool reduce13(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[13], values.data() + values.size() - 5);
+        states.resize(states.size() - 5);
+        values.resize(values.size() - 5);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 56:
+            states.push_back(67);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmts -> Stmt
+    template <typename Value, typename Actions>
+    static bool reduce14(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[14], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            states.push_back(10);
+            return true;
+        case 7:
+            states.push_back(19);
+            return true;
+        case 79:
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmts -> Stmts SCO Stmt
+    template <typename Value, typename Actions>
+    static bool reduce15(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[15], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            states.push_back(10);
+            return true;
+        case 7:
+            states.push_back(19);
+            return true;
+        case 79:
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> ε
+    template <typename Value, typename Actions>
+    static bool reduce16(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[16], values.data() + values.size());
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> ID ASG Expr
+    template <typename Value, typename Actions>
+    static bool reduce17(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[17], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> ID LBK Expr RBK ASG Expr
+    template <typename Value, typename Actions>
+    static bool reduce18(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[18], values.data() + values.size() - 6);
+        states.resize(states.size() - 6);
+        values.resize(values.size() - 6);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> IF LPA Cond RPA Stmt
+    template <typename Value, typename Actions>
+    static bool reduce19(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[19], values.data() + values.size() - 5);
+        states.resize(states.size() - 5);
+        values.resize(values.size() - 5);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> IF LPA Cond RPA Stmt ELSE Stmt
+    template <typename Value, typename Actions>
+    static bool reduce20(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[20], values.data() + values.size() - 7);
+        states.resize(states.size() - 7);
+        values.resize(values.size() - 7);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> WHILE LPA Cond RPA Stmt
+    template <typename Value, typename Actions>
+    static bool reduce21(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[21], values.data() + values.size() - 5);
+        states.resize(states.size() - 5);
+        values.resize(values.size() - 5);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> RETURN Expr
+    template <typename Value, typename Actions>
+    static bool reduce22(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[22], values.data() + values.size() - 2);
+        states.resize(states.size() - 2);
+        values.resize(values.size() - 2);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> LBR Stmts RBR
+    template <typename Value, typename Actions>
+    static bool reduce23(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[23], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Stmt -> ID LPA Args RPA
+    template <typename Value, typename Actions>
+    static bool reduce24(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[24], values.data() + values.size() - 4);
+        states.resize(states.size() - 4);
+        values.resize(values.size() - 4);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 1:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(10);
+            return true;
+        case 7:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(19);
+            return true;
+        case 25:
+            states.push_back(39);
+            return true;
+        case 48:
+            states.push_back(62);
+            return true;
+        case 57:
+            states.push_back(70);
+            return true;
+        case 74:
+            states.push_back(78);
+            return true;
+        case 79:
+            // 折叠 Stmts -> Stmt
+            values.back() = actions.reduce(productions[14], &values.back());
+            states.push_back(82);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> NUM
+    template <typename Value, typename Actions>
+    static bool reduce25(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[25], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> FLO
+    template <typename Value, typename Actions>
+    static bool reduce26(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[26], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> ID
+    template <typename Value, typename Actions>
+    static bool reduce27(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[27], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> ID LBK Expr RBK
+    template <typename Value, typename Actions>
+    static bool reduce28(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[28], values.data() + values.size() - 4);
+        states.resize(states.size() - 4);
+        values.resize(values.size() - 4);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> Expr ADD Expr
+    template <typename Value, typename Actions>
+    static bool reduce29(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[29], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> Expr MUL Expr
+    template <typename Value, typename Actions>
+    static bool reduce30(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[30], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> LPA Expr RPA
+    template <typename Value, typename Actions>
+    static bool reduce31(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[31], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Expr -> ID LPA Args RPA
+    template <typename Value, typename Actions>
+    static bool reduce32(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[32], values.data() + values.size() - 4);
+        states.resize(states.size() - 4);
+        values.resize(values.size() - 4);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 8:
+            states.push_back(20);
+            return true;
+        case 15:
+            states.push_back(28);
+            return true;
+        case 16:
+            states.push_back(29);
+            return true;
+        case 18:
+        case 27:
+            states.push_back(32);
+            return true;
+        case 23:
+            states.push_back(38);
+            return true;
+        case 30:
+        case 53:
+            states.push_back(45);
+            return true;
+        case 34:
+            states.push_back(50);
+            return true;
+        case 35:
+            states.push_back(51);
+            return true;
+        case 36:
+        case 60:
+            states.push_back(52);
+            return true;
+        case 49:
+            states.push_back(63);
+            return true;
+        case 58:
+            states.push_back(71);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Cond -> Expr ROP Expr
+    template <typename Value, typename Actions>
+    static bool reduce33(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[33], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 18:
+            states.push_back(31);
+            return true;
+        case 27:
+            states.push_back(42);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Cond -> Expr
+    template <typename Value, typename Actions>
+    static bool reduce34(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[34], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 18:
+            states.push_back(31);
+            return true;
+        case 27:
+            states.push_back(42);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Args -> ε
+    template <typename Value, typename Actions>
+    static bool reduce35(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[35], values.data() + values.size());
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 17:
+            states.push_back(30);
+            return true;
+        case 37:
+            states.push_back(53);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Args -> Args Arg CMA
+    template <typename Value, typename Actions>
+    static bool reduce36(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[36], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 17:
+            states.push_back(30);
+            return true;
+        case 37:
+            states.push_back(53);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Arg -> Expr
+    template <typename Value, typename Actions>
+    static bool reduce37(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[37], values.data() + values.size() - 1);
+        states.resize(states.size() - 1);
+        values.resize(values.size() - 1);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 30:
+        case 53:
+            states.push_back(44);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Arg -> ID LBK RBK
+    template <typename Value, typename Actions>
+    static bool reduce38(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[38], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 30:
+        case 53:
+            states.push_back(44);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Arg -> ID LBR RBR
+    template <typename Value, typename Actions>
+    static bool reduce39(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {
+        Value value = actions.reduce(productions[39], values.data() + values.size() - 3);
+        states.resize(states.size() - 3);
+        values.resize(values.size() - 3);
+        values.push_back(std::move(value));
+        switch (states.back()) {
+        case 30:
+        case 53:
+            states.push_back(44);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // 分析驱动：每个状态是一个按记号编号 switch 分派的代码块，语义值的构造和释放与表驱动分析相同
+    template <typename TokenSource, typename Actions, typename Report>
+    static typename Actions::Value parse(TokenSource& input, Actions& actions, const Production* productions, Report& report) {
+        using Value = typename Actions::Value;
+        std::vector<int> states;
+        std::vector<Value> values;
+        auto fail = [&]() {
+            for (Value& value : values) {
+                actions.discard(value);
+            }
+            return Value{};
+        };
+        states.push_back(0);
+        const Token* token = &input.next();
+        bool panick = false;
+        while (true) {
+            int kind = token->getKind();
+            if (kind < 0 || kind >= TERMINAL_COUNT) {
+                report.unknown(*token);
+                token = &input.next();
+                continue;
+            }
+            switch (states.back()) {
+            case 0:
+                switch (kind) {
+                case 4: // EOF
+                case 6: // FLOAT
+                case 7: // ID
+                case 8: // IF
+                case 9: // INT
+                case 11: // LBR
+                case 16: // RBR
+                case 17: // RETURN
+                case 20: // SCO
+                case 21: // VOID
+                case 22: // WHILE
+                    panick = false;
+                    if (!reduce1(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 1:
+                switch (kind) {
+                case 6: // FLOAT
+                    states.push_back(3);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(4);
+                    goto shift;
+                case 8: // IF
+                    states.push_back(5);
+                    goto shift;
+                case 9: // INT
+                    states.push_back(6);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(7);
+                    goto shift;
+                case 17: // RETURN
+                    states.push_back(8);
+                    goto shift;
+                case 21: // VOID
+                    states.push_back(12);
+                    goto shift;
+                case 22: // WHILE
+                    states.push_back(13);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce16(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 2:
+                switch (kind) {
+                case 20: // SCO
+                    states.push_back(14);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 3:
+                switch (kind) {
+                case 7: // ID
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce7(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 4:
+                switch (kind) {
+                case 1: // ASG
+                    states.push_back(15);
+                    goto shift;
+                case 10: // LBK
+                    states.push_back(16);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(17);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 5:
+                switch (kind) {
+                case 12: // LPA
+                    states.push_back(18);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 6:
+                switch (kind) {
+                case 7: // ID
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce6(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 7:
+                switch (kind) {
+                case 7: // ID
+                    states.push_back(4);
+                    goto shift;
+                case 8: // IF
+                    states.push_back(5);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(7);
+                    goto shift;
+                case 17: // RETURN
+                    states.push_back(8);
+                    goto shift;
+                case 22: // WHILE
+                    states.push_back(13);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce16(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 8:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 9:
+                switch (kind) {
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce14(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 10:
+                switch (kind) {
+                case 20: // SCO
+                    states.push_back(25);
+                    goto shift;
+                case 4: // EOF
+                {
+                    // 接受：Program -> Decls Stmts
+                    Value root = actions.reduce(productions[0], values.data() + values.size() - 2);
+                    values.resize(values.size() - 2);
+                    fail();
+                    return root;
+                }
+                default:
+                    goto error;
+                }
+            case 11:
+                switch (kind) {
+                case 7: // ID
+                    states.push_back(26);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 12:
+                switch (kind) {
+                case 7: // ID
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce8(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 13:
+                switch (kind) {
+                case 12: // LPA
+                    states.push_back(27);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 14:
+                switch (kind) {
+                case 4: // EOF
+                case 6: // FLOAT
+                case 7: // ID
+                case 8: // IF
+                case 9: // INT
+                case 11: // LBR
+                case 16: // RBR
+                case 17: // RETURN
+                case 20: // SCO
+                case 21: // VOID
+                case 22: // WHILE
+                    panick = false;
+                    if (!reduce2(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 15:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 16:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 17:
+                switch (kind) {
+                case 5: // FLO
+                case 7: // ID
+                case 12: // LPA
+                case 14: // NUM
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce35(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 18:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 19:
+                switch (kind) {
+                case 20: // SCO
+                    states.push_back(25);
+                    goto shift;
+                case 16: // RBR
+                    states.push_back(33);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 20:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce22(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 21:
+                switch (kind) {
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce26(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 22:
+                switch (kind) {
+                case 10: // LBK
+                    states.push_back(36);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(37);
+                    goto shift;
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce27(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 23:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 24:
+                switch (kind) {
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce25(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 25:
+                switch (kind) {
+                case 7: // ID
+                    states.push_back(4);
+                    goto shift;
+                case 8: // IF
+                    states.push_back(5);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(7);
+                    goto shift;
+                case 17: // RETURN
+                    states.push_back(8);
+                    goto shift;
+                case 22: // WHILE
+                    states.push_back(13);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce16(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 26:
+                switch (kind) {
+                case 10: // LBK
+                    states.push_back(40);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(41);
+                    goto shift;
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce3(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 27:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 28:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce17(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 29:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 15: // RBK
+                    states.push_back(43);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 30:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(46);
+                    goto shift;
+                case 19: // RPA
+                    states.push_back(47);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 31:
+                switch (kind) {
+                case 19: // RPA
+                    states.push_back(48);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 32:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 18: // ROP
+                    states.push_back(49);
+                    goto shift;
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce34(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 33:
+                switch (kind) {
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce23(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 34:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 35:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 36:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 37:
+                switch (kind) {
+                case 5: // FLO
+                case 7: // ID
+                case 12: // LPA
+                case 14: // NUM
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce35(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 38:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 19: // RPA
+                    states.push_back(54);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 39:
+                switch (kind) {
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce15(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 40:
+                switch (kind) {
+                case 14: // NUM
+                    states.push_back(55);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 41:
+                switch (kind) {
+                case 6: // FLOAT
+                case 9: // INT
+                case 19: // RPA
+                case 21: // VOID
+                    panick = false;
+                    if (!reduce9(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 42:
+                switch (kind) {
+                case 19: // RPA
+                    states.push_back(57);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 43:
+                switch (kind) {
+                case 1: // ASG
+                    states.push_back(58);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 44:
+                switch (kind) {
+                case 2: // CMA
+                    states.push_back(59);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 45:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 2: // CMA
+                    panick = false;
+                    if (!reduce37(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 46:
+                switch (kind) {
+                case 12: // LPA
+                    states.push_back(37);
+                    goto shift;
+                case 10: // LBK
+                    states.push_back(60);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(61);
+                    goto shift;
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce27(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 47:
+                switch (kind) {
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce24(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 48:
+                switch (kind) {
+                case 7: // ID
+                    states.push_back(4);
+                    goto shift;
+                case 8: // IF
+                    states.push_back(5);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(7);
+                    goto shift;
+                case 17: // RETURN
+                    states.push_back(8);
+                    goto shift;
+                case 22: // WHILE
+                    states.push_back(13);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce16(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 49:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 50:
+                switch (kind) {
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce29(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 51:
+                switch (kind) {
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce30(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 52:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 15: // RBK
+                    states.push_back(64);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 53:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(46);
+                    goto shift;
+                case 19: // RPA
+                    states.push_back(65);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 54:
+                switch (kind) {
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce31(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 55:
+                switch (kind) {
+                case 15: // RBK
+                    states.push_back(66);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 56:
+                switch (kind) {
+                case 6: // FLOAT
+                    states.push_back(3);
+                    goto shift;
+                case 9: // INT
+                    states.push_back(6);
+                    goto shift;
+                case 21: // VOID
+                    states.push_back(12);
+                    goto shift;
+                case 19: // RPA
+                    states.push_back(68);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 57:
+                switch (kind) {
+                case 7: // ID
+                    states.push_back(4);
+                    goto shift;
+                case 8: // IF
+                    states.push_back(5);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(7);
+                    goto shift;
+                case 17: // RETURN
+                    states.push_back(8);
+                    goto shift;
+                case 22: // WHILE
+                    states.push_back(13);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce16(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 58:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 59:
+                switch (kind) {
+                case 5: // FLO
+                case 7: // ID
+                case 12: // LPA
+                case 14: // NUM
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce36(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 60:
+                switch (kind) {
+                case 5: // FLO
+                    states.push_back(21);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(22);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(23);
+                    goto shift;
+                case 14: // NUM
+                    states.push_back(24);
+                    goto shift;
+                case 15: // RBK
+                    states.push_back(72);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 61:
+                switch (kind) {
+                case 16: // RBR
+                    states.push_back(73);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 62:
+                switch (kind) {
+                case 3: // ELSE
+                    states.push_back(74);
+                    goto shift;
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce19(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 63:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 19: // RPA
+                    panick = false;
+                    if (!reduce33(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 64:
+                switch (kind) {
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce28(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 65:
+                switch (kind) {
+                case 0: // ADD
+                case 2: // CMA
+                case 3: // ELSE
+                case 4: // EOF
+                case 13: // MUL
+                case 15: // RBK
+                case 16: // RBR
+                case 18: // ROP
+                case 19: // RPA
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce32(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 66:
+                switch (kind) {
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce4(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 67:
+                switch (kind) {
+                case 20: // SCO
+                    states.push_back(75);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 68:
+                switch (kind) {
+                case 11: // LBR
+                    states.push_back(76);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 69:
+                switch (kind) {
+                case 7: // ID
+                    states.push_back(77);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 70:
+                switch (kind) {
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce21(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 71:
+                switch (kind) {
+                case 0: // ADD
+                    states.push_back(34);
+                    goto shift;
+                case 13: // MUL
+                    states.push_back(35);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce18(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 72:
+                switch (kind) {
+                case 2: // CMA
+                    panick = false;
+                    if (!reduce38(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 73:
+                switch (kind) {
+                case 2: // CMA
+                    panick = false;
+                    if (!reduce39(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 74:
+                switch (kind) {
+                case 7: // ID
+                    states.push_back(4);
+                    goto shift;
+                case 8: // IF
+                    states.push_back(5);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(7);
+                    goto shift;
+                case 17: // RETURN
+                    states.push_back(8);
+                    goto shift;
+                case 22: // WHILE
+                    states.push_back(13);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce16(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 75:
+                switch (kind) {
+                case 6: // FLOAT
+                case 9: // INT
+                case 19: // RPA
+                case 21: // VOID
+                    panick = false;
+                    if (!reduce10(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 76:
+                switch (kind) {
+                case 4: // EOF
+                case 6: // FLOAT
+                case 7: // ID
+                case 8: // IF
+                case 9: // INT
+                case 11: // LBR
+                case 16: // RBR
+                case 17: // RETURN
+                case 20: // SCO
+                case 21: // VOID
+                case 22: // WHILE
+                    panick = false;
+                    if (!reduce1(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 77:
+                switch (kind) {
+                case 10: // LBK
+                    states.push_back(80);
+                    goto shift;
+                case 12: // LPA
+                    states.push_back(81);
+                    goto shift;
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce11(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 78:
+                switch (kind) {
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce20(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 79:
+                switch (kind) {
+                case 6: // FLOAT
+                    states.push_back(3);
+                    goto shift;
+                case 7: // ID
+                    states.push_back(4);
+                    goto shift;
+                case 8: // IF
+                    states.push_back(5);
+                    goto shift;
+                case 9: // INT
+                    states.push_back(6);
+                    goto shift;
+                case 11: // LBR
+                    states.push_back(7);
+                    goto shift;
+                case 17: // RETURN
+                    states.push_back(8);
+                    goto shift;
+                case 21: // VOID
+                    states.push_back(12);
+                    goto shift;
+                case 22: // WHILE
+                    states.push_back(13);
+                    goto shift;
+                case 3: // ELSE
+                case 4: // EOF
+                case 16: // RBR
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce16(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 80:
+                switch (kind) {
+                case 15: // RBK
+                    states.push_back(83);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 81:
+                switch (kind) {
+                case 6: // FLOAT
+                    states.push_back(3);
+                    goto shift;
+                case 9: // INT
+                    states.push_back(6);
+                    goto shift;
+                case 21: // VOID
+                    states.push_back(12);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 82:
+                switch (kind) {
+                case 20: // SCO
+                    states.push_back(25);
+                    goto shift;
+                case 16: // RBR
+                    states.push_back(85);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 83:
+                switch (kind) {
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce12(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 84:
+                switch (kind) {
+                case 19: // RPA
+                    states.push_back(86);
+                    goto shift;
+                default:
+                    goto error;
+                }
+            case 85:
+                switch (kind) {
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce5(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            case 86:
+                switch (kind) {
+                case 20: // SCO
+                    panick = false;
+                    if (!reduce13(states, values, actions, productions)) report.gotoMissing(*token);
+                    continue;
+                default:
+                    goto error;
+                }
+            default:
+                goto error;
+            }
+        shift:
+            panick = false;
+            values.push_back(actions.shift(*token));
+            if (kind == EOF_KIND) return fail();
+            token = &input.next();
+            continue;
+        error:
+            if (!panick) report.error(*token);
+            panick = true;
+            if (kind == EOF_KIND) return fail();
+            token = &input.next();
+        }
+    }
+};
+
+#endif
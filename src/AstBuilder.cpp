@@ -2,299 +2,349 @@
 #include "AstBuilder.hpp" 
 using namespace std;
 
-Node* AstBuilder::visit(ParseTreeNode* node) {
-    if (node->symbol == "ε") {
-        return nullptr;
-    } else if (node->symbol == "Program") {
-        vector<Node*> decls_nodes = visitDecls(node->children[0]);
-        vector<Node*> stmts_nodes = visitStmts(node->children[1]);
-        
-        // 将Node*转换为Decl*和Stmt*
-        vector<Decl*> decls;
-        for (Node* n : decls_nodes) {
-            decls.push_back(dynamic_cast<Decl*>(n));
-        }
-        vector<Stmt*> stmts;
-        for (Node* n : stmts_nodes) {
-            stmts.push_back(dynamic_cast<Stmt*>(n));
-        }
-        
-        return new Program(node->start, node->end, decls, stmts);
-    } else if (node->symbol == "Decl") {
-        if (node->children.size() == 2) {
+AstBuilder::AstBuilder(const Vocabulary& vocab, const vector<Production>& productions) {
+    sym.Program = vocab.find("Program");
+    sym.Decls = vocab.find("Decls");
+    sym.Decl = vocab.find("Decl");
+    sym.Type = vocab.find("Type");
+    sym.Params = vocab.find("Params");
+    sym.Param = vocab.find("Param");
+    sym.Stmts = vocab.find("Stmts");
+    sym.Stmt = vocab.find("Stmt");
+    sym.Expr = vocab.find("Expr");
+    sym.Cond = vocab.find("Cond");
+    sym.Args = vocab.find("Args");
+    sym.Arg = vocab.find("Arg");
+    sym.ID = vocab.find("ID");
+    sym.ASG = vocab.find("ASG");
+    sym.LBK = vocab.find("LBK");
+    sym.LPA = vocab.find("LPA");
+    sym.LBR = vocab.find("LBR");
+    sym.IF = vocab.find("IF");
+    sym.WHILE = vocab.find("WHILE");
+    sym.RETURN = vocab.find("RETURN");
+    sym.NUM = vocab.find("NUM");
+    sym.FLO = vocab.find("FLO");
+    sym.ADD = vocab.find("ADD");
+    sym.MUL = vocab.find("MUL");
+    for (const Production& prod : productions) {
+        actions.push_back(actionOf(prod));
+    }
+}
+
+AstBuilder::Action AstBuilder::actionOf(const Production& prod) const {
+    const vector<int>& rhs = prod.rhs;
+    size_t size = rhs.size();
+    if (prod.lhs == sym.Program) {
+        // Decls Stmts
+        return PROGRAM;
+    } else if (prod.lhs == sym.Decls || prod.lhs == sym.Params || prod.lhs == sym.Args) {
+        // ε | Decls Decl SCO
+        return size == 0 ? LIST_EMPTY : LIST_APPEND;
+    } else if (prod.lhs == sym.Stmts) {
+        // Stmt | Stmts SCO Stmt
+        return size == 1 ? LIST_FIRST : size == 3 ? LIST_APPEND_LAST : NONE;
+    } else if (prod.lhs == sym.Decl) {
+        if (size == 2) {
             // Type ID
-            Type* type = dynamic_cast<Type*>(visit(node->children[0]));
-            Id* id = new Id(node->children[1]->start, node->children[1]->end, node->children[1]->token_value);
-            return new VarDecl(node->start, node->end, type, id, 0);
-        } else if (node->children.size() == 5) {
+            return VAR_DECL;
+        } else if (size == 5) {
             // Type ID LBK NUM RBK
-            Type* type = dynamic_cast<Type*>(visit(node->children[0]));
-            Id* id = new Id(node->children[1]->start, node->children[1]->end, node->children[1]->token_value);
-            int dimension = stoi(node->children[3]->token_value);
-            if (dimension <= 0) {
-                err(node, "dimension is not positive");
-                dimension = 1;
-            }
-            return new VarDecl(node->start, node->end, type, id, dimension);
-        } else if (node->children.size() == 9) {
+            return ARRAY_DECL;
+        } else if (size == 9) {
             // Type ID LPA Params RPA LBR Decls Stmts RBR
-            Type* retType = dynamic_cast<Type*>(visit(node->children[0]));
-            Id* id = new Id(node->children[1]->start, node->children[1]->end, node->children[1]->token_value);
-            vector<Node*> params_nodes = visitParams(node->children[3]);
-            vector<Node*> decls_nodes = visitDecls(node->children[6]);
-            vector<Node*> stmts_nodes = visitStmts(node->children[7]);
-            
-            // 转换为对应类型
-            vector<Decl*> params;
-            for (Node* n : params_nodes) {
-                params.push_back(dynamic_cast<Decl*>(n));
-            }
-            vector<Decl*> decls;
-            for (Node* n : decls_nodes) {
-                decls.push_back(dynamic_cast<Decl*>(n));
-            }
-            vector<Stmt*> stmts;
-            for (Node* n : stmts_nodes) {
-                stmts.push_back(dynamic_cast<Stmt*>(n));
-            }
-            
-            return new FuncDecl(node->start, node->end, retType, id, params, decls, stmts);
+            return FUNC_DECL;
         }
-    } else if (node->symbol == "Type") {
-        return new Type(node->start, node->end, node->children[0]->token_value);
-    } else if (node->symbol == "Param") {
-        if (node->children.size() == 2) {
+    } else if (prod.lhs == sym.Type) {
+        return TYPE;
+    } else if (prod.lhs == sym.Param) {
+        if (size == 2) {
             // Type ID
-            Type* type = dynamic_cast<Type*>(visit(node->children[0]));
-            Id* id = new Id(node->children[1]->start, node->children[1]->end, node->children[1]->token_value);
-            return new VarDecl(node->start, node->end, type, id, 0);
-        } else if (node->children.size() == 4) {
+            return VAR_DECL;
+        } else if (size == 4) {
             // Type ID LBK RBK
-            Type* type = dynamic_cast<Type*>(visit(node->children[0]));
-            Id* id = new Id(node->children[1]->start, node->children[1]->end, node->children[1]->token_value);
-            return new VarDecl(node->start, node->end, type, id, -1); // -1表示数组参数
-        } else if (node->children.size() == 5) {
+            return ARRAY_PARAM;
+        } else if (size == 5) {
             // Type ID LPA Type RPA (函数指针参数
-            Type* type = dynamic_cast<Type*>(visit(node->children[0]));
-            Type* paramType = dynamic_cast<Type*>(visit(node->children[3]));
-            Id* id = new Id(node->children[1]->start, node->children[1]->end, node->children[1]->token_value);
-            vector<Decl *> params;
-            params.push_back(new VarDecl(node->children[3]->start, node->children[3]->end, paramType, nullptr, 0));
-            vector<Decl *> decls;
-            vector<Stmt *> stmts;
-            return new FuncDecl(node->start, node->end, type, id, params, decls, stmts);
+            return FUNC_PARAM;
         }
-    } else if (node->symbol == "Stmt") {
-        if (node->children.size() == 0) {
-            // ε
-            return nullptr;
-        } else if (node->children.size() == 3 && node->children[1]->symbol == "ASG") {
+    } else if (prod.lhs == sym.Stmt) {
+        if (size == 3 && rhs[1] == sym.ASG) {
             // ID ASG Expr
-            Id* target = new Id(node->children[0]->start, node->children[0]->end, node->children[0]->token_value);
-            Expr* value = dynamic_cast<Expr*>(visit(node->children[2]));
-            return new Assign(node->start, node->end, target, value);
-        } else if (node->children.size() == 6 && node->children[1]->symbol == "LBK") {
+            return ASSIGN;
+        } else if (size == 6 && rhs[1] == sym.LBK) {
             // ID LBK Expr RBK ASG Expr
-            Id* id = new Id(node->children[0]->start, node->children[1]->end, node->children[0]->token_value);
-            Expr* dimension = dynamic_cast<Expr*>(visit(node->children[2]));
-            Index* target = new Index(node->children[0]->start, node->children[1]->end, id, dimension);
-            Expr* value = dynamic_cast<Expr*>(visit(node->children[5]));
-            return new Assign(node->start, node->end, target, value);
-        } else if (node->children.size() == 5 && node->children[0]->symbol == "IF") {
+            return INDEX_ASSIGN;
+        } else if (size == 5 && rhs[0] == sym.IF) {
             // IF LPA Cond RPA Stmt
-            Expr* cond = dynamic_cast<Expr*>(visit(node->children[2]));
-            Stmt* thenStmt = dynamic_cast<Stmt*>(visit(node->children[4]));
-            return new If(node->start, node->end, cond, thenStmt);
-        } else if (node->children.size() == 7 && node->children[0]->symbol == "IF") {
+            return IF;
+        } else if (size == 7 && rhs[0] == sym.IF) {
             // IF LPA Cond RPA Stmt ELSE Stmt
-            Expr* cond = dynamic_cast<Expr*>(visit(node->children[2]));
-            Stmt* thenStmt = dynamic_cast<Stmt*>(visit(node->children[4]));
-            Stmt* elseStmt = dynamic_cast<Stmt*>(visit(node->children[6]));
-            return new If(node->start, node->end, cond, thenStmt, elseStmt);
-        } else if (node->children.size() == 5 && node->children[0]->symbol == "WHILE") {
+            return IF_ELSE;
+        } else if (size == 5 && rhs[0] == sym.WHILE) {
             // WHILE LPA Cond RPA Stmt
-            Expr* cond = dynamic_cast<Expr*>(visit(node->children[2]));
-            Stmt* body = dynamic_cast<Stmt*>(visit(node->children[4]));
-            return new While(node->start, node->end, cond, body);
-        } else if (node->children.size() == 2 && node->children[0]->symbol == "RETURN") {
+            return WHILE;
+        } else if (size == 2 && rhs[0] == sym.RETURN) {
             // RETURN Expr
-            Expr* value = dynamic_cast<Expr*>(visit(node->children[1]));
-            return new Return(node->start, node->end, value);
-        } else if (node->children.size() == 3 && node->children[0]->symbol == "LBR") {
+            return RETURN;
+        } else if (size == 3 && rhs[0] == sym.LBR) {
             // LBR Stmts RBR
-            vector<Node*> stmts_nodes = visitStmts(node->children[1]);
-            vector<Stmt*> stmts;
-            for (Node* n : stmts_nodes) {
-                stmts.push_back(dynamic_cast<Stmt*>(n));
-            }
-            return new Block(node->start, node->end, stmts);
-        } else if (node->children.size() == 4 && node->children[1]->symbol == "LPA") {
+            return BLOCK;
+        } else if (size == 4 && rhs[1] == sym.LPA) {
             // ID LPA Args RPA
-            Id* id = new Id(node->children[0]->start, node->children[0]->end, node->children[0]->token_value);
-            vector<Node*> args_nodes = visitArgs(node->children[2]);
-            vector<Expr*> args;
-            for (Node* n : args_nodes) {
-                args.push_back(dynamic_cast<Expr*>(n));
-            }
-            Call* call = new Call(node->children[0]->start, node->children[1]->end, id, args);
-            return new ExprEval(node->start, node->end, call);
+            return CALL_STMT;
         }
-    } else if (node->symbol == "Expr") {
-        if (node->children.size() == 1) {
-            if (node->children[0]->symbol == "NUM") {
-                // NUM
-                int value = stoi(node->children[0]->token_value);
-                return new Int(node->children[0]->start, node->children[0]->end, value);
-            } else if (node->children[0]->symbol == "FLO") {
-                // FLO
-                float value = stof(node->children[0]->token_value);
-                return new Float(node->children[0]->start, node->children[0]->end, value);
-            } else if (node->children[0]->symbol == "ID") {
-                // ID
-                return new Id(node->children[0]->start, node->children[0]->end, node->children[0]->token_value);
-            }
-        } else if (node->children.size() == 3) {
-            if (node->children[0]->symbol == "LPA") {
-                // LPA Expr RPA
-                return visit(node->children[1]);
-            } else if (node->children[1]->symbol == "ADD" || node->children[1]->symbol == "MUL") {
-                // Expr ADD/MUL Expr
-                Expr* left = dynamic_cast<Expr*>(visit(node->children[0]));
-                char op = (node->children[1]->symbol == "ADD") ? '+' : '*';
-                Expr* right = dynamic_cast<Expr*>(visit(node->children[2]));
-                return new Binary(node->children[1]->start, node->children[0]->end, op, left, right);
-            }
-        } else if (node->children.size() == 4) {
-            if (node->children[1]->symbol == "LBK") {
-                // ID LBK Expr RBK
-                Id* id = new Id(node->children[0]->start, node->children[0]->end, node->children[0]->token_value);
-                Expr* dimension = dynamic_cast<Expr*>(visit(node->children[2]));
-                return new Index(node->children[0]->start, node->children[0]->end, id, dimension);
-            } else if (node->children[1]->symbol == "LPA") {
-                // ID LPA Args RPA
-                Id* id = new Id(node->children[0]->start, node->children[0]->end, node->children[0]->token_value);
-                vector<Node*> args_nodes = visitArgs(node->children[2]);
-                vector<Expr*> args;
-                for (Node* n : args_nodes) {
-                    args.push_back(dynamic_cast<Expr*>(n));
-                }
-                return new Call(node->children[0]->start, node->children[0]->end, id, args);
-            }
-        }
-    } else if (node->symbol == "Cond") {
-        if (node->children.size() == 1) {
-            // Expr
-            return visit(node->children[0]);
-        } else if (node->children.size() == 3) {
-            // Expr ROP Expr
-            Expr* left = dynamic_cast<Expr*>(visit(node->children[0]));
-            char op = '='; 
-            if (node->children[1]->token_value == "<") op = '<';
-            else if (node->children[1]->token_value == ">") op = '>';
-            else if (node->children[1]->token_value == "==") op = '=';
-            else if (node->children[1]->token_value == "!=") op = '!';
-            else if (node->children[1]->token_value == "<=") op = 'l';
-            else if (node->children[1]->token_value == ">=") op = 'g';
-            
-            Expr* right = dynamic_cast<Expr*>(visit(node->children[2]));
-            return new Binary(node->children[1]->start, node->children[1]->end, op, left, right);
+    } else if (prod.lhs == sym.Expr) {
+        if (size == 1) {
+            // NUM | FLO | ID
+            return rhs[0] == sym.NUM ? INT : rhs[0] == sym.FLO ? FLOAT : rhs[0] == sym.ID ? ID : NONE;
+        } else if (size == 3 && rhs[0] == sym.LPA) {
+            // LPA Expr RPA
+            return PASS_SECOND;
+        } else if (size == 3 && (rhs[1] == sym.ADD || rhs[1] == sym.MUL)) {
+            // Expr ADD/MUL Expr
+            return BINARY;
+        } else if (size == 4 && rhs[1] == sym.LBK) {
+            // ID LBK Expr RBK
+            return INDEX;
+        } else if (size == 4 && rhs[1] == sym.LPA) {
+            // ID LPA Args RPA
+            return CALL;
         }
-    } else if (node->symbol == "Arg") {
-        if (node->children.size() == 1) {
+    } else if (prod.lhs == sym.Cond) {
+        // Expr | Expr ROP Expr
+        return size == 1 ? PASS_FIRST : size == 3 ? COND_BINARY : NONE;
+    } else if (prod.lhs == sym.Arg) {
+        if (size == 1) {
             // Expr
-            return visit(node->children[0]);
-        } else if (node->children.size() == 3) {
-            if (node->children[1]->symbol == "LBK") {
-                // ID LBK RBK
-                Id* id = new Id(node->children[0]->start, node->children[0]->end, node->children[0]->token_value);
-                return new Index(node->children[0]->start, node->children[0]->end, id, nullptr); // 空索引表示整个数组
-            } else if (node->children[1]->symbol == "LBR") {
-                // ID LBR RBR
-                return new Id(node->children[0]->start, node->children[0]->end, node->children[0]->token_value);
-            }
+            return PASS_FIRST;
+        } else if (size == 3 && rhs[1] == sym.LBK) {
+            // ID LBK RBK
+            return ARRAY_ARG;
+        } else if (size == 3 && rhs[1] == sym.LBR) {
+            // ID LBR RBR
+            return ID_ARG;
         }
     }
-    return nullptr;
+    return NONE;
 }
 
-vector<Node*> AstBuilder::visitDecls(ParseTreeNode* node) {
-    vector<Node*> result;
-    if (node->symbol == "ε") {
-        return result;
-    } else if (node->symbol == "Decls") {
-        if (node->children.size() == 0) {
-            return result;
-        } else {
-            // Decls Decl SCO
-            result = visitDecls(node->children[0]);
-            Node* decl = visit(node->children[1]);
-            if (decl != nullptr) {
-                result.push_back(decl);
-            }
-        }
+// 将收集的结点转换为对应类型
+template <typename T>
+static vector<T*> castAll(const vector<Node*>& nodes) {
+    vector<T*> result;
+    for (Node* n : nodes) {
+        result.push_back(dynamic_cast<T*>(n));
     }
     return result;
 }
 
-vector<Node*> AstBuilder::visitStmts(ParseTreeNode* node) {
-    vector<Node*> result;
-    if (node->symbol == "ε") {
-        return result;
-    } else if (node->symbol == "Stmts") {
-        if (node->children.size() == 1) {
-            // Stmt
-            Node* stmt = visit(node->children[0]);
-            if (stmt != nullptr) {
-                result.push_back(stmt);
-            }
-        } else if (node->children.size() == 3) {
-            // Stmts SCO Stmt
-            result = visitStmts(node->children[0]);
-            Node* stmt = visit(node->children[2]);
-            if (stmt != nullptr) {
-                result.push_back(stmt);
-            }
+// 由终结符的语义值构造标识符
+static Id* idOf(const AstBuilder::Value& value) {
+    return new Id(value.start, value.end, string(value.start.getValue()));
+}
+
+AstBuilder::Value AstBuilder::apply(int production, Value* rhs, int count) {
+    Value result;
+    if (count > 0) {
+        result.start = rhs[0].start;
+        result.end = rhs[count - 1].end;
+    }
+    Token start = result.start;
+    Token end = result.end;
+    switch (actions[production]) {
+    case PROGRAM:
+        result.node = new Program(start, end, castAll<Decl>(rhs[0].list), castAll<Stmt>(rhs[1].list));
+        break;
+    case LIST_EMPTY:
+        break;
+    case LIST_APPEND:
+        result.list = std::move(rhs[0].list);
+        if (rhs[1].node != nullptr) {
+            result.list.push_back(rhs[1].node);
+        }
+        break;
+    case LIST_APPEND_LAST:
+        result.list = std::move(rhs[0].list);
+        if (rhs[2].node != nullptr) {
+            result.list.push_back(rhs[2].node);
+        }
+        break;
+    case LIST_FIRST:
+        if (rhs[0].node != nullptr) {
+            result.list.push_back(rhs[0].node);
         }
+        break;
+    case VAR_DECL:
+        result.node = new VarDecl(start, end, dynamic_cast<Type*>(rhs[0].node), idOf(rhs[1]), 0);
+        break;
+    case ARRAY_DECL: {
+        Type* type = dynamic_cast<Type*>(rhs[0].node);
+        Id* id = idOf(rhs[1]);
+        int dimension = stoi(string(rhs[3].start.getValue()));
+        if (dimension <= 0) {
+            err(start, end, "dimension is not positive");
+            dimension = 1;
+        }
+        result.node = new VarDecl(start, end, type, id, dimension);
+        break;
+    }
+    case FUNC_DECL:
+        result.node = new FuncDecl(start, end, dynamic_cast<Type*>(rhs[0].node), idOf(rhs[1]),
+            castAll<Decl>(rhs[3].list), castAll<Decl>(rhs[6].list), castAll<Stmt>(rhs[7].list));
+        break;
+    case TYPE:
+        result.node = new Type(start, end, string(rhs[0].start.getValue()));
+        break;
+    case ARRAY_PARAM:
+        result.node = new VarDecl(start, end, dynamic_cast<Type*>(rhs[0].node), idOf(rhs[1]), -1); // -1表示数组参数
+        break;
+    case FUNC_PARAM: {
+        Type* type = dynamic_cast<Type*>(rhs[0].node);
+        Type* paramType = dynamic_cast<Type*>(rhs[3].node);
+        Id* id = idOf(rhs[1]);
+        vector<Decl *> params;
+        params.push_back(new VarDecl(rhs[3].start, rhs[3].end, paramType, nullptr, 0));
+        result.node = new FuncDecl(start, end, type, id, params, vector<Decl *>(), vector<Stmt *>());
+        break;
+    }
+    case ASSIGN:
+        result.node = new Assign(start, end, idOf(rhs[0]), dynamic_cast<Expr*>(rhs[2].node));
+        break;
+    case INDEX_ASSIGN: {
+        Id* id = new Id(rhs[0].start, rhs[1].end, string(rhs[0].start.getValue()));
+        Index* target = new Index(rhs[0].start, rhs[1].end, id, dynamic_cast<Expr*>(rhs[2].node));
+        result.node = new Assign(start, end, target, dynamic_cast<Expr*>(rhs[5].node));
+        break;
+    }
+    case IF:
+        result.node = new If(start, end, dynamic_cast<Expr*>(rhs[2].node), dynamic_cast<Stmt*>(rhs[4].node));
+        break;
+    case IF_ELSE:
+        result.node = new If(start, end, dynamic_cast<Expr*>(rhs[2].node), dynamic_cast<Stmt*>(rhs[4].node),
+            dynamic_cast<Stmt*>(rhs[6].node));
+        break;
+    case WHILE:
+        result.node = new While(start, end, dynamic_cast<Expr*>(rhs[2].node), dynamic_cast<Stmt*>(rhs[4].node));
+        break;
+    case RETURN:
+        result.node = new Return(start, end, dynamic_cast<Expr*>(rhs[1].node));
+        break;
+    case BLOCK:
+        result.node = new Block(start, end, castAll<Stmt>(rhs[1].list));
+        break;
+    case CALL_STMT: {
+        Call* call = new Call(rhs[0].start, rhs[1].end, idOf(rhs[0]), castAll<Expr>(rhs[2].list));
+        result.node = new ExprEval(start, end, call);
+        break;
+    }
+    case INT:
+        result.node = new Int(rhs[0].start, rhs[0].end, stoi(string(rhs[0].start.getValue())));
+        break;
+    case FLOAT:
+        result.node = new Float(rhs[0].start, rhs[0].end, stof(string(rhs[0].start.getValue())));
+        break;
+    case ID:
+        result.node = idOf(rhs[0]);
+        break;
+    case INDEX:
+        result.node = new Index(rhs[0].start, rhs[0].end, idOf(rhs[0]), dynamic_cast<Expr*>(rhs[2].node));
+        break;
+    case BINARY: {
+        char op = (rhs[1].start.getKind() == sym.ADD) ? '+' : '*';
+        result.node = new Binary(rhs[1].start, rhs[0].end, op, dynamic_cast<Expr*>(rhs[0].node), dynamic_cast<Expr*>(rhs[2].node));
+        break;
+    }
+    case CALL:
+        result.node = new Call(rhs[0].start, rhs[0].end, idOf(rhs[0]), castAll<Expr>(rhs[2].list));
+        break;
+    case PASS_FIRST:
+        result.node = rhs[0].node;
+        break;
+    case PASS_SECOND:
+        result.node = rhs[1].node;
+        break;
+    case COND_BINARY: {
+        string_view rop = rhs[1].start.getValue();
+        char op = '=';
+        if (rop == "<") op = '<';
+        else if (rop == ">") op = '>';
+        else if (rop == "==") op = '=';
+        else if (rop == "!=") op = '!';
+        else if (rop == "<=") op = 'l';
+        else if (rop == ">=") op = 'g';
+        result.node = new Binary(rhs[1].start, rhs[1].end, op, dynamic_cast<Expr*>(rhs[0].node), dynamic_cast<Expr*>(rhs[2].node));
+        break;
+    }
+    case ARRAY_ARG:
+        result.node = new Index(rhs[0].start, rhs[0].end, idOf(rhs[0]), nullptr); // 空索引表示整个数组
+        break;
+    case ID_ARG:
+        result.node = idOf(rhs[0]);
+        break;
+    case NONE:
+        break;
     }
     return result;
 }
 
-vector<Node*> AstBuilder::visitParams(ParseTreeNode* node) {
-    vector<Node*> result;
-    if (node->symbol == "ε") {
-        return result;
-    } else if (node->symbol == "Params") {
-        if (node->children.size() == 0) {
-            return result;
-        } else {
-            // Params Param SCO
-            result = visitParams(node->children[0]);
-            Node* param = visit(node->children[1]);
-            if (param != nullptr) {
-                result.push_back(param);
-            }
+AstBuilder::Value AstBuilder::reduce(const Production& prod, Value* rhs) {
+    int count = prod.rhs.size();
+    if (failure) {
+        // 已无法得到完整的AST，只维护位置供分析继续进行
+        for (int i = 0; i < count; i++) {
+            discard(rhs[i]);
         }
+        Value result;
+        if (count > 0) {
+            result.start = rhs[0].start;
+            result.end = rhs[count - 1].end;
+        }
+        return result;
+    }
+    try {
+        return apply(prod.id, rhs, count);
+    } catch (...) {
+        failure = current_exception();
+        return Value{};
     }
-    return result;
 }
 
-vector<Node*> AstBuilder::visitArgs(ParseTreeNode* node) {
-    vector<Node*> result;
-    if (node->symbol == "ε") {
-        return result;
-    } else if (node->symbol == "Args") {
-        if (node->children.size() == 0) {
-            return result;
-        } else {
-            // Args Arg CMA
-            result = visitArgs(node->children[0]);
-            Node* arg = visit(node->children[1]);
-            if (arg != nullptr) {
-                result.push_back(arg);
-            }
-        }
+void AstBuilder::discard(Value& value) {
+    delete value.node;
+    for (Node* n : value.list) {
+        delete n;
     }
-    return result;
+    value.node = nullptr;
+    value.list.clear();
+}
+
+Program* AstBuilder::accept(Value& value) {
+    return dynamic_cast<Program*>(value.node);
+}
+
+void AstBuilder::rethrow() {
+    if (failure) {
+        exception_ptr pending = failure;
+        failure = nullptr;
+        rethrow_exception(pending);
+    }
+}
+
+AstBuilder::Value AstBuilder::build(ParseTreeNode* node) {
+    if (node->is_terminal) {
+        return Value{node->start, node->end, nullptr, {}};
+    }
+    vector<Value> children;
+    children.reserve(node->children.size());
+    for (ParseTreeNode* child : node->children) {
+        children.push_back(build(child));
+    }
+    return apply(node->production, children.data(), children.size());
+}
+
+Node* AstBuilder::visit(ParseTreeNode* node) {
+    return build(node).node;
 }
 
 void AstBuilder::outputErrors(string file) {
@@ -1,31 +1,111 @@
 #ifndef AST_BUILDER_HPP
 #define AST_BUILDER_HPP
 
+#include <exception>
 #include <vector>
 #include <string>
 #include <iostream>
-#include "util/parsetree.hpp"  
-#include "util/astnodes.hpp"     
-#include "util/error.hpp"    
+#include "util/parsetree.hpp"
+#include "util/parserule.hpp"
+#include "util/astnodes.hpp"
+#include "util/error.hpp"
+#include "util/vocabulary.hpp"
 
+/// @brief 由产生式的语义动作构造AST
+/// 语法分析驱动在移进和归约时直接调用 shift/reduce，在值栈上构造AST，不经过解析树；
+/// 已有解析树时也可用 visit 按同样的语义动作自底向上构造
 class AstBuilder {
+public:
+    /// @brief 值栈上的语义值
+    struct Value {
+        /// @brief 开始与结束token，与解析树结点的 start/end 相同
+        Token start;
+        Token end;
+        /// @brief 构造出的AST结点，没有结点时为空
+        Node* node{nullptr};
+        /// @brief 列表类非终结符（Decls、Stmts、Params、Args）收集的结点
+        std::vector<Node*> list;
+    };
+
 private:
     std::vector<Error> errors;
-    
-    void err(ParseTreeNode* node, std::string errMsg) {
-        size_t pos[4] = {node->start.getPos()[0], node->start.getPos()[1], node->end.getPos()[2], node->end.getPos()[3]};
-        Error error("Semantic", pos, errMsg);
+
+    /// @brief 语义动作，由产生式的左部和右部确定
+    enum Action {
+        NONE,
+        PROGRAM,
+        LIST_EMPTY, LIST_APPEND, LIST_APPEND_LAST, LIST_FIRST,
+        VAR_DECL, ARRAY_DECL, FUNC_DECL, TYPE,
+        ARRAY_PARAM, FUNC_PARAM,
+        ASSIGN, INDEX_ASSIGN, IF, IF_ELSE, WHILE, RETURN, BLOCK, CALL_STMT,
+        INT, FLOAT, ID, INDEX, BINARY, CALL, PASS_FIRST, PASS_SECOND,
+        COND_BINARY, ARRAY_ARG, ID_ARG
+    };
+
+    /// @brief 用到的文法符号编号，构造时从符号编号表中查出
+    struct {
+        int Program, Decls, Decl, Type, Params, Param, Stmts, Stmt, Expr, Cond, Args, Arg;
+        int ID, ASG, LBK, LPA, LBR, IF, WHILE, RETURN, NUM, FLO, ADD, MUL;
+    } sym;
+
+    /// @brief 产生式编号 -> 语义动作
+    std::vector<Action> actions;
+
+    /// @brief 分析过程中语义动作抛出的异常，推迟到确认分析无误后再抛出
+    std::exception_ptr failure;
+
+    void err(Token start, Token end, std::string errMsg) {
+        Error error("Semantic", start.getStart(), end.getEnd(), errMsg);
         errors.push_back(error);
     }
-    
-    std::vector<Node*> visitDecls(ParseTreeNode* node);
-    std::vector<Node*> visitStmts(ParseTreeNode* node);
-    std::vector<Node*> visitParams(ParseTreeNode* node);
-    std::vector<Node*> visitArgs(ParseTreeNode* node);
+
+    /// @brief 确定产生式的语义动作
+    Action actionOf(const Production& prod) const;
+
+    /// @brief 执行语义动作
+    /// @param production 产生式编号
+    /// @param rhs 右部各符号的语义值，结点和列表会被移走
+    /// @param count 右部长度
+    Value apply(int production, Value* rhs, int count);
+
+    /// @brief 自底向上对解析树执行语义动作
+    Value build(ParseTreeNode* node);
 
 public:
+    AstBuilder(const Vocabulary& vocab, const std::vector<Production>& productions);
+
+    /// @brief 移进终结符时的语义值
+    /// @param token 终结符
+    /// @return
+    Value shift(const Token& token) {
+        return Value{token, token, nullptr, {}};
+    }
+
+    /// @brief 归约时执行产生式的语义动作
+    /// 动作抛出的异常会被记下，之后的归约不再构造结点，由 rethrow 重新抛出
+    /// @param prod 产生式
+    /// @param rhs 右部各符号的语义值
+    /// @return 左部的语义值
+    Value reduce(const Production& prod, Value* rhs);
+
+    /// @brief 释放语义值上的结点
+    /// @param value
+    void discard(Value& value);
+
+    /// @brief 取出分析成功后开始符号的语义值中的程序结点
+    /// @param value 开始符号的语义值
+    /// @return
+    Program* accept(Value& value);
+
+    /// @brief 重新抛出分析过程中语义动作抛出的异常
+    /// 在确认没有词法和语法错误后调用，与先建解析树再构造AST时的行为一致
+    void rethrow();
+
+    /// @brief 由解析树构造AST
+    /// @param node 解析树结点
+    /// @return
     Node* visit(ParseTreeNode* node);
-    
+
     // Optionally add a method to get collected errors
     std::vector<Error> getErrors() const { return errors; }
     void clearErrors() { errors.clear(); }
@@ -38,7 +118,10 @@ public:
     }
     bool hasErr() { return !errors.empty(); }
 
-    void clear() { errors.clear(); }
+    void clear() {
+        errors.clear();
+        failure = nullptr;
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
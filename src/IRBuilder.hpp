@@ -19,7 +19,7 @@ private:
     std::vector<Error> errors;
 
     void err(Node* node, std::string errMsg) {
-        Error error("Semantic", node->getPos(), errMsg);
+        Error error("Semantic", node->getStart(), node->getEnd(), errMsg);
         errors.push_back(error);
     }
 
@@ -1,6 +1,7 @@
 #include "Lexer.hpp"
 #include <iostream>
 #include <fstream>
+#include <thread>
 #include "util/dfa.hpp"
 #include "util/error.hpp"
 #include "util/token.hpp"
@@ -8,34 +9,203 @@
 
 using namespace std;
 
-void Lexer::lex(string input) {
+Token Lexer::scan(const SourceBuffer& source, size_t& i) {
+    string_view input = source.view();
 
-    for (size_t i = 0; i < input.size();) {
-        auto p = dfa.recognizeString(input.substr(i));
-        string token = p.first;
+    while (i < input.size()) {
+        // 每个空白字符都单独构成SKIP记号，连续的空白可以一次跳过
+        i = blanks.skip(input, i);
+        if (i == input.size()) break;
+        auto p = dfa.match(input, i);
         size_t ori = i;
         i += p.second;
-        if (token == "SKIP") {
-            continue;
-        }
-        if (token == "") {
-            auto line_col = posToLineCol(i, input);
-            size_t pos[4]{line_col.first, line_col.second, line_col.first, line_col.second};
-            err(pos, "near " + input.substr(i, 1));
+        if (p.first < 0) {
+            err(source.pos(i), "near " + string(input.substr(i, 1)));
             i++;
             //cout << "(" << token << ", " << str << ")" << endl;
         } else {
-            auto start_lc = posToLineCol(ori, input);
-            auto end_lc = posToLineCol(i, input);
-            size_t pos[4]{start_lc.first, start_lc.second, end_lc.first, end_lc.second};
-            Token t(pos, token, input.substr(ori, p.second));
-            tokens.push_back(t);
+            int kind = kindOf(p.first, input.substr(ori, p.second));
+            if (kind == skipKind) {
+                continue;
+            }
+            return Token(source.pos(ori), source.pos(i), kind, input.substr(ori, p.second));
+        }
+    }
+    i = input.size();
+    return Token(source.pos(i), source.pos(i), eofKind, "");
+}
+
+void Lexer::lex(const SourceBuffer& source) {
+    size_t i = 0;
+    do {
+        tokens.push_back(scan(source, i));
+    } while (tokens.back().getKind() != eofKind);
+}
+
+Lexer::Segment Lexer::lexSegment(const SourceBuffer& source, size_t pos, size_t limit, int state, const Segment* from) const {
+    string_view input = source.view();
+    // 在分块内运行DFA；停在分块末尾时看下一个字节判断token是否延续到下一块
+    string_view chunk = input.substr(0, limit);
+    auto continues = [&](const pair<int, size_t>& p) {
+        return p.second == limit && limit < input.size() && dfa.step(p.first, input[limit]) >= 0;
+    };
+    auto error = [&](size_t at, Segment& seg) {
+        seg.errors.emplace_back("Lexer", source.pos(at), source.pos(at), "near " + string(input.substr(at, 1)));
+    };
+
+    Segment seg;
+    size_t i = pos;
+    if (state != dfa.getStart()) {
+        auto p = dfa.run(chunk, i, state);
+        if (continues(p)) {
+            seg.headPending = true;
+            seg.tailPending = true;
+            seg.tailState = p.first;
+            return seg;
+        }
+        seg.headEnd = p.second;
+        seg.headToken = dfa.acceptToken(p.first);
+        i = p.second;
+        if (seg.headToken < 0) {
+            error(i, seg);
+            i++;
+        }
+    }
+
+    while (i < limit) {
+        i = blanks.skip(chunk, i);
+        if (i == limit) break;
+        if (from) {
+            // 到达开始状态结果中的某个token边界，此后的结果必然相同
+            auto it = lower_bound(from->steps.begin(), from->steps.end(), make_pair(i, make_pair(size_t(0), size_t(0))));
+            if (it != from->steps.end() && it->first == i) {
+                seg.joined = true;
+                seg.joinToken = it->second.first;
+                seg.joinError = it->second.second;
+                seg.tailPending = from->tailPending;
+                seg.tailStart = from->tailStart;
+                seg.tailState = from->tailState;
+                seg.resume = from->resume;
+                return seg;
+            }
+        } else {
+            seg.steps.push_back({i, {seg.tokens.size(), seg.errors.size()}});
+        }
+        auto p = dfa.run(chunk, i, dfa.getStart());
+        if (continues(p)) {
+            seg.tailPending = true;
+            seg.tailStart = i;
+            seg.tailState = p.first;
+            return seg;
+        }
+        int token = dfa.acceptToken(p.first);
+        if (token < 0) {
+            error(p.second, seg);
+            i = p.second + 1;
+            continue;
+        }
+        int kind = kindOf(token, input.substr(i, p.second - i));
+        if (kind != skipKind) {
+            seg.tokens.emplace_back(source.pos(i), source.pos(p.second), kind, input.substr(i, p.second - i));
+        }
+        i = p.second;
+    }
+    seg.resume = i;
+    return seg;
+}
+
+void Lexer::lexParallel(const SourceBuffer& source, unsigned threads, size_t minChunk) {
+    string_view input = source.view();
+    size_t chunks = min<size_t>(threads, input.size() / max<size_t>(minChunk, 1));
+    if (chunks <= 1) {
+        lex(source);
+        return;
+    }
+
+    // 分块边界取在换行之后
+    vector<size_t> bounds{0};
+    for (size_t k = 1; k < chunks; k++) {
+        size_t nl = input.find('\n', max(k * (input.size() / chunks), bounds.back()));
+        if (nl == string_view::npos || nl + 1 >= input.size()) break;
+        bounds.push_back(nl + 1);
+    }
+    bounds.push_back(input.size());
+    chunks = bounds.size() - 1;
+
+    // 每块对每个入口状态投机分析；非开始状态的结果在回到token边界后直接复用开始状态的结果
+    vector<vector<Segment>> results(chunks, vector<Segment>(entryStates.size()));
+    vector<thread> workers;
+    for (size_t k = 0; k < chunks; k++) {
+        workers.emplace_back([&, k]() {
+            results[k][0] = lexSegment(source, bounds[k], bounds[k + 1], entryStates[0], nullptr);
+            for (size_t e = 1; e < entryStates.size() && k > 0; e++) {
+                results[k][e] = lexSegment(source, bounds[k], bounds[k + 1], entryStates[e], &results[k][0]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    size_t total = 1;
+    for (const auto& result : results) {
+        total += result[0].tokens.size();
+    }
+    tokens.reserve(tokens.size() + total);
+
+    // 按上一块的结束状态选取结果并拼接
+    bool pending = false;
+    size_t pendingStart = 0;
+    int pendingState = -1;
+    size_t next = 0;
+    for (size_t k = 0; k < chunks; k++) {
+        Segment redo;
+        const Segment* seg = nullptr;
+        if (!pending) {
+            if (next == bounds[k]) {
+                seg = &results[k][0];
+            } else {
+                // 出错后跳过的字符越过了分块边界，顺序地重新分析
+                redo = lexSegment(source, next, bounds[k + 1], dfa.getStart(), nullptr);
+                seg = &redo;
+            }
+        } else {
+            auto it = find(entryStates.begin(), entryStates.end(), pendingState);
+            if (it != entryStates.end()) {
+                seg = &results[k][it - entryStates.begin()];
+            } else {
+                redo = lexSegment(source, bounds[k], bounds[k + 1], pendingState, nullptr);
+                seg = &redo;
+            }
+            if (!seg->headPending) {
+                if (seg->headToken >= 0) {
+                    string_view text = input.substr(pendingStart, seg->headEnd - pendingStart);
+                    int kind = kindOf(seg->headToken, text);
+                    if (kind != skipKind) {
+                        tokens.emplace_back(source.pos(pendingStart), source.pos(seg->headEnd), kind, text);
+                    }
+                }
+                pending = false;
+            }
+        }
+        tokens.insert(tokens.end(), seg->tokens.begin(), seg->tokens.end());
+        errors.insert(errors.end(), seg->errors.begin(), seg->errors.end());
+        if (seg->joined) {
+            const Segment& from = results[k][0];
+            tokens.insert(tokens.end(), from.tokens.begin() + seg->joinToken, from.tokens.end());
+            errors.insert(errors.end(), from.errors.begin() + seg->joinError, from.errors.end());
+        }
+        if (seg->headPending) {
+            pendingState = seg->tailState;
+        } else if (seg->tailPending) {
+            pending = true;
+            pendingStart = seg->tailStart;
+            pendingState = seg->tailState;
+        } else {
+            next = seg->resume;
         }
     }
-    auto lc = posToLineCol(input.size(), input);
-    size_t pos[4]{lc.first, lc.second, lc.first, lc.second};
-    Token t(pos, "EOF", "");
-    tokens.push_back(t);
+    tokens.emplace_back(source.pos(input.size()), source.pos(input.size()), eofKind, "");
 }
 
 void Lexer::printErrors() {
@@ -46,7 +216,7 @@ void Lexer::printErrors() {
 
 void Lexer::printTokens() {
     for (auto t : tokens) {
-        cout << t.toString() << endl;
+        cout << t.toString(vocab) << endl;
     }
 }
 
@@ -57,7 +227,7 @@ void Lexer::outputTokens(string file) {
         return;
     }
     for (auto t : tokens) {
-        f << t.toString() << endl;
+        f << t.toString(vocab) << endl;
     }
     f.close();
 }
@@ -1,42 +1,131 @@
 #ifndef LEXER_HPP
 #define LEXER_HPP
 
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "util/dfa.hpp"
 #include "util/error.hpp"
+#include "util/keywords.hpp"
+#include "util/source.hpp"
 #include "util/token.hpp"
+#include "util/vocabulary.hpp"
 
 class Lexer {
     private:
         DFA dfa;
+        Vocabulary& vocab;
+        /// @brief DFA的token编号 -> 记号编号
+        std::vector<int> kinds;
+        int skipKind;
+        int eofKind;
+        /// @brief 单独构成SKIP记号的字节（空白），可以成段跳过而不经过DFA
+        ByteSet blanks;
+        /// @brief 关键字分类器，DFA不识别关键字时由它把标识符再分为关键字
+        KeywordHash keywords;
         std::vector<Error> errors;
         std::vector<Token> tokens;
+        /// @brief 分块边界（换行之后）处可能处于的DFA状态，用于并行词法分析时投机
+        std::vector<int> entryStates;
 
-        void err(size_t position[], std::string errMsg) {
-            Error error("Lexer", position, errMsg);
-            errors.push_back(error);
-        }
+        /// @brief 并行词法分析中一个分块以某个入口状态分析的结果
+        struct Segment {
+            /// @brief 整块都在延续上一块未结束的token
+            bool headPending{false};
+            /// @brief 延续的token的结束偏移
+            size_t headEnd{0};
+            /// @brief 延续的token接受的DFA token编号，-1 表示出错
+            int headToken{-1};
+            std::vector<Token> tokens;
+            std::vector<Error> errors;
+            /// @brief 已与开始状态的结果汇合，其后的token和错误从开始状态结果的这两个下标起取用
+            bool joined{false};
+            size_t joinToken{0};
+            size_t joinError{0};
+            /// @brief 每次识别开始时的 (偏移, token数, 错误数)，用于与其他入口状态的结果汇合
+            std::vector<std::pair<size_t, std::pair<size_t, size_t>>> steps;
+            /// @brief 块末尾有未结束的token
+            bool tailPending{false};
+            /// @brief 未结束token的开始偏移和当前状态
+            size_t tailStart{0};
+            int tailState{-1};
+            /// @brief 没有未结束token时，下一块应开始识别的偏移
+            size_t resume{0};
+        };
 
-        std::pair<size_t, size_t> posToLineCol(size_t idx, std::string str) {
-            size_t line = 1;
-            size_t col = 1;
-            for (size_t i = 0; i < str.size(); i++) {
-                char c = str[i];
-                if (i == idx) break;
-                if (c == '\n') {
-                    line++;
-                    col = 0;
+        /// @brief 分析一个分块，不修改词法分析器
+        /// @param source 源程序
+        /// @param pos 开始偏移
+        /// @param limit 分块结束偏移，越过它的token只记为未结束
+        /// @param state 开始时的DFA状态，非开始状态表示在延续上一块的token
+        /// @param from 同一分块以开始状态分析的结果，可以在token边界处直接汇合，为空则不汇合
+        /// @return 
+        Segment lexSegment(const SourceBuffer& source, size_t pos, size_t limit, int state, const Segment* from) const;
+
+        /// @brief DFA token编号对应的记号编号，标识符会再经关键字分类
+        int kindOf(int token, std::string_view text) const {
+            int kind = kinds[token];
+            if (kind == keywords.identKind()) {
+                int keyword = keywords.classify(text);
+                if (keyword >= 0) {
+                    kind = keyword;
                 }
-                col++;
             }
-            return std::make_pair(line, col);
+            return kind;
         }
+
+        void err(SourcePos position, std::string errMsg) {
+            Error error("Lexer", position, position, errMsg);
+            errors.push_back(error);
+        }
+
+        /// @brief 从 pos 开始识别下一个token，跳过空白和注释，非法字符记为错误后继续
+        /// @param source 源程序
+        /// @param pos 当前偏移，返回时指向token之后
+        /// @return 识别到的token，到达末尾后总是返回EOF
+        Token scan(const SourceBuffer& source, size_t& pos);
+
+        friend class TokenCursor;
         
     public:
-        Lexer(DFA dfa) : dfa(dfa) {}
+        /// @brief 构造函数，词法规则中的记号名在此时统一换成编号
+        /// @param dfa 
+        /// @param vocab 符号编号表，文法符号应已先行编号
+        /// @param keywordTable 关键字哈希表，为空表示关键字由DFA本身识别
+        Lexer(DFA dfa, Vocabulary& vocab, const KeywordTable* keywordTable = nullptr) : dfa(dfa), vocab(vocab) {
+            if (keywordTable) {
+                keywords = KeywordHash(*keywordTable, vocab);
+            }
+            for (const std::string& token : this->dfa.getTokens()) {
+                kinds.push_back(vocab.intern(token));
+            }
+            skipKind = vocab.intern("SKIP");
+            eofKind = vocab.intern("EOF");
+            for (size_t i = 0; i < kinds.size(); i++) {
+                if (kinds[i] == skipKind) {
+                    blanks = this->dfa.singleByteTokens(i);
+                }
+            }
+            // 换行后要么在token开头，要么在延续跨行的token（如块注释）
+            entryStates.push_back(this->dfa.getStart());
+            for (int state : this->dfa.targets('\n')) {
+                if (this->dfa.hasTransitions(state) || this->dfa.acceptToken(state) < 0) {
+                    entryStates.push_back(state);
+                }
+            }
+        }
 
-        void lex(std::string input);
+        /// @brief 词法分析，生成的token直接引用源程序缓冲区中的字符
+        /// @param source 源程序，须在token使用期间保持有效
+        void lex(const SourceBuffer& source);
+
+        /// @brief 并行词法分析，结果（包括位置和错误）与 lex 完全相同
+        /// 在换行处分块，每块对每个可能的入口状态投机地分析，再按上一块的结束状态选取并拼接
+        /// @param source 源程序，须在token使用期间保持有效
+        /// @param threads 线程数
+        /// @param minChunk 每块的最小字节数，源程序较小时退化为顺序分析
+        void lexParallel(const SourceBuffer& source, unsigned threads, size_t minChunk = 1 << 20);
 
         bool hasErr() {
             return !errors.empty();
@@ -50,7 +139,7 @@ class Lexer {
 
         void outputErrors(const std::string& file);
 
-        std::vector<Token> getTokens() {
+        const std::vector<Token>& getTokens() const {
             return tokens;
         }
 
@@ -60,4 +149,39 @@ class Lexer {
         }
 };
 
+/// @brief 词法分析游标：语法分析器按需逐个取token，不生成token序列
+class TokenCursor {
+    private:
+        Lexer& lexer;
+        const SourceBuffer& source;
+        size_t pos{0};
+        /// @brief 最近取出的token
+        Token current;
+
+    public:
+        /// @brief 构造函数
+        /// @param lexer 词法错误记录在其中
+        /// @param source 源程序，须在token使用期间保持有效
+        TokenCursor(Lexer& lexer, const SourceBuffer& source) : lexer(lexer), source(source) {}
+
+        /// @brief 取下一个token
+        /// @return 到达末尾后总是返回EOF；引用在下一次调用前有效
+        const Token& next() {
+            current = lexer.scan(source, pos);
+            return current;
+        }
+};
+
+/// @brief 将已生成的token序列包装成与 TokenCursor 相同的取token接口
+struct VectorCursor {
+    const std::vector<Token>& tokens;
+    size_t index;
+
+    /// @brief 取下一个token
+    /// @return 到达末尾后总是返回最后一个token（EOF）
+    const Token& next() {
+        return tokens[std::min(index++, tokens.size() - 1)];
+    }
+};
+
 #endif
\ No newline at end of file
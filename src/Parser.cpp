@@ -4,8 +4,15 @@
 #include <sstream>
 #include <algorithm>
 #include <queue>
+#include <unordered_map>
 #include <fstream>
 #include <iomanip>
+#include <cstring>
+#include <climits>
+#include <atomic>
+#include <thread>
+#include <unistd.h>
+#include "util/source.hpp"
 
 using namespace std;
 
@@ -58,386 +65,618 @@ void LRParser::parseGrammar(const vector<string>& input) {
     
     // 添加终结符 EOF 表示输入结束
     terminals.insert("EOF");
-}
 
-// 计算闭包
-set<Item> LRParser::closure(const set<Item>& items) {
-    set<Item> result = items;
-    bool changed = true;
-    
-    while (changed) {
-        changed = false;
-        set<Item> new_items = result;
-        
-        for (const Item& item : result) {
-            // 如果点在产生式右部末尾，则跳过
-            if (item.dot_position >= item.production.right.size()) {
-                continue;
+    // 为文法符号编号：终结符在前，编号即ACTION表的列号；非终结符在后
+    if (vocab.size() != 0) {
+        throw runtime_error("Grammar symbols must be numbered before any other token.");
+    }
+    for (const string& terminal : terminals) {
+        vocab.intern(terminal);
+    }
+    for (const string& non_terminal : non_terminals) {
+        vocab.intern(non_terminal);
+    }
+    terminal_count = terminals.size();
+    for (Production& prod : productions) {
+        prod.lhs = vocab.find(prod.left);
+        for (const string& symbol : prod.right) {
+            prod.rhs.push_back(vocab.find(symbol));
+        }
+    }
+
+    // 优先级声明：%left 或 %right 后列出终结符，同一行优先级相同，后声明的行优先级更高
+    precedence.assign(terminal_count, 0);
+    right_assoc.assign(terminal_count, false);
+    int level = 0;
+    for (const string& line : input) {
+        vector<string> words = tokenize(line);
+        if (words.empty() || (words[0] != "%left" && words[0] != "%right")) continue;
+        level++;
+        for (size_t i = 1; i < words.size(); i++) {
+            int symbol = vocab.find(words[i]);
+            if (symbol < 0 || symbol >= terminal_count) {
+                throw runtime_error("Precedence declared for unknown terminal: " + words[i]);
             }
-            
-            // 获取点后面的符号
-            string next_symbol = item.production.right[item.dot_position];
-            
-            // 如果点后面的符号是非终结符
-            if (non_terminals.find(next_symbol) != non_terminals.end()) {
-                
-                for (const Production& prod : productions) {
-                    if (prod.left == next_symbol) {
-                        
-                        // 创建新项
-                        Item new_item;
-                        new_item.production = prod;
-                        new_item.dot_position = 0;
-
-                        // 添加到结果集中
-                        if (new_items.insert(new_item).second) {
-                            changed = true;
-                        }
-                    }
-                }
+            precedence[symbol] = level;
+            right_assoc[symbol] = words[0] == "%right";
+        }
+    }
+    // 产生式的优先级取右部最后一个终结符的优先级
+    production_precedence.assign(productions.size(), 0);
+    for (const Production& prod : productions) {
+        for (int i = prod.rhs.size() - 1; i >= 0; i--) {
+            if (prod.rhs[i] < terminal_count) {
+                production_precedence[prod.id] = precedence[prod.rhs[i]];
+                break;
             }
         }
-        
-        result = new_items;
     }
-    
-    return result;
 }
 
-// 计算GOTO函数
-set<Item> LRParser::computeGoto(const set<Item>& items, const string& symbol) {
-    set<Item> result;
+// 计算闭包：项按产生式编号和点的位置编码，每个非终结符的产生式只展开一次
+vector<Item> LRParser::closure(const vector<Item>& kernel) const {
+    vector<Item> result = kernel;
+    vector<bool> expanded(vocab.size() - terminal_count, false);
     
-    for (const Item& item : items) {
+    for (size_t i = 0; i < result.size(); i++) {
+        const Production& prod = productions[result[i].production];
         // 如果点在产生式右部末尾，则跳过
-        if (item.dot_position >= item.production.right.size()) {
+        if (result[i].dot_position >= (int)prod.rhs.size()) {
             continue;
         }
         
-        // 如果点后面的符号与给定符号相同
-        if (item.production.right[item.dot_position] == symbol) {
-            // 创建新项，将点右移一位
-            Item new_item;
-            new_item.production = item.production;
-            new_item.dot_position = item.dot_position+1;
-            result.insert(new_item);
+        // 如果点后面的符号是尚未展开的非终结符，加入它的全部产生式
+        int next_symbol = prod.rhs[result[i].dot_position];
+        if (next_symbol >= terminal_count && !expanded[next_symbol - terminal_count]) {
+            expanded[next_symbol - terminal_count] = true;
+            for (int p : productions_by_left[next_symbol - terminal_count]) {
+                result.push_back(Item{p, 0});
+            }
+        }
+    }
+    
+    // 与按产生式（左部, 右部）排序的项集顺序一致
+    sort(result.begin(), result.end(), [this](const Item& a, const Item& b) {
+        if (production_rank[a.production] != production_rank[b.production]) {
+            return production_rank[a.production] < production_rank[b.production];
         }
+        return a.dot_position < b.dot_position;
+    });
+    result.erase(unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+// 产生式按左部分组并按（左部, 右部）的字典序排名，转移符号按名称排名，并确定项的整数编码
+void LRParser::prepareCollection() {
+    productions_by_left.assign(vocab.size() - terminal_count, vector<int>());
+    vector<int> order(productions.size());
+    for (size_t p = 0; p < productions.size(); p++) {
+        productions_by_left[productions[p].lhs - terminal_count].push_back(p);
+        order[p] = p;
+    }
+    stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return productions[a] < productions[b];
+    });
+    production_rank.assign(productions.size(), 0);
+    for (size_t r = 0; r < order.size(); r++) {
+        production_rank[order[r]] = r;
     }
 
-    // 计算闭包
-    return closure(result);
+    // 转移符号按名称顺序处理，与项集编号的既有顺序一致
+    name_rank.assign(vocab.size(), 0);
+    vector<int> by_name(vocab.size());
+    for (size_t i = 0; i < by_name.size(); i++) {
+        by_name[i] = i;
+    }
+    sort(by_name.begin(), by_name.end(), [this](int a, int b) {
+        return vocab.name(a) < vocab.name(b);
+    });
+    for (size_t r = 0; r < by_name.size(); r++) {
+        name_rank[by_name[r]] = r;
+    }
+    item_stride = 1;
+    for (const Production& prod : productions) {
+        item_stride = max(item_stride, prod.rhs.size() + 1);
+    }
+
+    canonical_collection.clear();
+    kernels.clear();
+    closed.clear();
+    buckets.assign(vocab.size(), vector<int>());
+    vector<int> initial{0};
+    internKernel(initial);
+}
+
+// 按核心项的整数编码查找项集，不存在时新建只含核心项的项集，闭包在展开时才计算
+int LRParser::internKernel(const vector<int>& kernel) {
+    auto found = kernels.find(kernel);
+    if (found != kernels.end()) {
+        return found->second;
+    }
+    ItemSet new_set;
+    for (int code : kernel) {
+        new_set.items.push_back(Item{(int)(code / item_stride), (int)(code % item_stride)});
+    }
+    canonical_collection.push_back(new_set);
+    closed.push_back(false);
+    int index = canonical_collection.size() - 1;
+    kernels.emplace(kernel, index);
+    return index;
+}
+
+// 计算项集的闭包，按转移符号的名称顺序返回各转移的核心项编码
+// 只读写项集 state 本身和 buckets，不同的项集可以在不同线程中同时计算
+vector<pair<int, vector<int>>> LRParser::closeState(int state, vector<vector<int>>& buckets) {
+    canonical_collection[state].items = closure(canonical_collection[state].items);
+
+    // 按点后面的符号对项分组，组内点右移一位即为GOTO的核心项
+    vector<int> symbols;
+    for (const Item& item : canonical_collection[state].items) {
+        const Production& prod = productions[item.production];
+        if (item.dot_position < (int)prod.rhs.size()) {
+            int symbol = prod.rhs[item.dot_position];
+            if (buckets[symbol].empty()) {
+                symbols.push_back(symbol);
+            }
+            buckets[symbol].push_back(item.production * item_stride + item.dot_position + 1);
+        }
+    }
+    sort(symbols.begin(), symbols.end(), [&](int a, int b) {
+        return name_rank[a] < name_rank[b];
+    });
+
+    vector<pair<int, vector<int>>> result;
+    result.reserve(symbols.size());
+    for (int symbol : symbols) {
+        vector<int>& kernel = buckets[symbol];
+        sort(kernel.begin(), kernel.end());
+        result.emplace_back(symbol, kernel);
+        kernel.clear();
+    }
+    return result;
+}
+
+// 按转移符号的顺序登记转移到的项集，新项集追加在项集族末尾
+void LRParser::addTransitions(int state, const vector<pair<int, vector<int>>>& transitions) {
+    closed[state] = true;
+    for (const auto& [symbol, kernel] : transitions) {
+        int target = internKernel(kernel);
+        canonical_collection[state].goto_transitions.emplace_back(symbol, target);
+    }
+}
+
+// 计算项集的闭包和全部转移，转移到的新项集追加在项集族末尾
+void LRParser::expandState(int state) {
+    addTransitions(state, closeState(state, buckets));
 }
 
 // 构建规范LR(0)项集族
+// 点不在最左边的项（核心项）唯一确定一个项集，因此用核心项的整数编码在哈希表中查找已有项集
+// 新项集总是追加在末尾，按编号顺序展开即为BFS
 void LRParser::buildCanonicalCollection() {
-    // 创建初始项集I0
-    set<Item> initial_items;
-    Item initial_item;
-    initial_item.production = productions[0];
-    initial_item.dot_position = 0;
-    initial_items.insert(initial_item);
-    
-    // 计算I0的闭包
-    set<Item> initial_closure = closure(initial_items);
-    
-    // 创建初始项集
-    ItemSet initial_set;
-    initial_set.items = initial_closure;
-    canonical_collection.push_back(initial_set);
-    
-    // 使用BFS算法构建项集族
-    queue<int> queue;
-    queue.push(0);  // 从I0开始
-    while (!queue.empty()) {
-        int current_index = queue.front();
-        queue.pop();
-        
-        // 收集所有可能的转移符号
-        set<string> symbols;
-        {
-            const ItemSet& current_set_for_symbols = canonical_collection[current_index];
-            for (const Item& item : current_set_for_symbols.items) {
-                if (item.dot_position < item.production.right.size()) {
-                    symbols.insert(item.production.right[item.dot_position]);
-                }
-            }
+    prepareCollection();
+    if (build_threads <= 1) {
+        for (size_t state = 0; state < canonical_collection.size(); state++) {
+            expandState(state);
         }
-        
-        // 对每个符号计算GOTO
-        for (const string& symbol : symbols) {
-            
-            set<Item> goto_result = computeGoto(canonical_collection[current_index].items, symbol);
-            // 如果结果非空
-            if (!goto_result.empty()) {
-                // 检查是否已经存在相同的项集
-                int existing_index = -1;
-                for (size_t i = 0; i < canonical_collection.size(); i++) {
-                    if (canonical_collection[i].items == goto_result) {
-                        existing_index = i;
-                        break;
+        return;
+    }
+
+    // BFS的一层是上一层展开时新增的项集，层内的闭包和GOTO核心项互不依赖，分给多个线程计算；
+    // 之后按项集编号顺序登记转移，新项集的编号与顺序构建完全相同
+    vector<vector<pair<int, vector<int>>>> level;
+    size_t begin = 0;
+    while (begin < canonical_collection.size()) {
+        size_t end = canonical_collection.size();
+        level.assign(end - begin, {});
+        size_t workers = min<size_t>(build_threads, (end - begin) / MIN_STATES_PER_THREAD);
+        if (workers <= 1) {
+            for (size_t state = begin; state < end; state++) {
+                level[state - begin] = closeState(state, buckets);
+            }
+        } else {
+            atomic<size_t> next{begin};
+            vector<thread> pool;
+            for (size_t w = 0; w < workers; w++) {
+                pool.emplace_back([&]() {
+                    vector<vector<int>> local(vocab.size());
+                    for (size_t state; (state = next++) < end;) {
+                        level[state - begin] = closeState(state, local);
                     }
-                }
-                
-                if (existing_index == -1) {
-                    // 如果不存在，则添加新项集
-                    ItemSet new_set;
-                    new_set.items = goto_result;
-                    canonical_collection.push_back(new_set);
-                    existing_index = canonical_collection.size() - 1;
-                    queue.push(existing_index);
-                }
-                // 添加转移
-                canonical_collection[current_index].goto_transitions[symbol] = existing_index;
+                });
+            }
+            for (auto& worker : pool) {
+                worker.join();
             }
         }
+        for (size_t state = begin; state < end; state++) {
+            addTransitions(state, level[state - begin]);
+        }
+        begin = end;
     }
 }
 
-// 计算FIRST集合
+// 计算可空性和FIRST集合
+// 先按“右部尚未确定可空的符号数”倒数求出可空的非终结符，再沿 FIRST(Y) ⊆ FIRST(X) 的依赖边用工作表传播
 void LRParser::computeFirstSets() {
-    bool changed = true;
-    
-    // 为每个终结符初始化FIRST集合
-    for (const string& terminal : terminals) {
-        first_sets[terminal].insert(terminal);
-    }
-    
-    // 为每个非终结符初始化空的FIRST集合
-    for (const string& non_terminal : non_terminals) {
-        first_sets[non_terminal] = set<string>();
-    }
-    
-    // 重复计算直到不再发生变化
-    while (changed) {
-        changed = false;
-        
-        for (const Production& production : productions) {
-            const string& left = production.left;
-            const vector<string>& right = production.right;
-            
-            // 如果是空产生式 A -> ε
-            if (right.empty()) {
-                if (first_sets[left].insert("ε").second) {
-                    changed = true;
-                }
-                continue;
+    int non_terminal_count = vocab.size() - terminal_count;
+    nullable.assign(non_terminal_count, false);
+    first_sets.assign(non_terminal_count, SymbolSet(terminal_count));
+
+    // 非终结符 -> 右部含有它的产生式（按出现次数重复）
+    vector<vector<int>> occurrences(non_terminal_count);
+    vector<int> remaining(productions.size());
+    vector<int> worklist;
+    for (const Production& prod : productions) {
+        remaining[prod.id] = prod.rhs.size();
+        for (int symbol : prod.rhs) {
+            if (symbol >= terminal_count) {
+                occurrences[symbol - terminal_count].push_back(prod.id);
             }
-            
-            // 计算产生式右部的FIRST集合
-            set<string> right_first;
-            bool contains_epsilon = true;
-            
-            for (const string& symbol : right) {
-                // 如果当前符号的FIRST集合不包含ε，则后续符号不再考虑
-                if (!contains_epsilon) break;
-                
-                // 如果当前符号是终结符
-                if (terminals.find(symbol) != terminals.end()) {
-                    right_first.insert(symbol);
-                    contains_epsilon = false;
-                } else {
-                    // 如果当前符号是非终结符
-                    const set<string>& symbol_first = first_sets[symbol];
-                    // 添加除ε以外的所有符号
-                    for (const string& terminal : symbol_first) {
-                        if (terminal != "ε") {
-                            right_first.insert(terminal);
-                        }
-                    }
-                    // 检查是否包含ε
-                    contains_epsilon = symbol_first.find("ε") != symbol_first.end();
-                }
+        }
+        // 空产生式 A -> ε
+        if (prod.rhs.empty() && !nullable[prod.lhs - terminal_count]) {
+            nullable[prod.lhs - terminal_count] = true;
+            worklist.push_back(prod.lhs - terminal_count);
+        }
+    }
+    while (!worklist.empty()) {
+        int non_terminal = worklist.back();
+        worklist.pop_back();
+        for (int p : occurrences[non_terminal]) {
+            int left = productions[p].lhs - terminal_count;
+            if (--remaining[p] == 0 && !nullable[left]) {
+                nullable[left] = true;
+                worklist.push_back(left);
             }
-            
-            // 如果所有右部符号都可以推导出ε，则将ε添加到FIRST(left)
-            if (contains_epsilon) {
-                right_first.insert("ε");
+        }
+    }
+
+    // 右部前缀可空时，其后的终结符直接加入FIRST(left)，非终结符 Y 连一条 Y -> left 的依赖边
+    vector<vector<int>> dependents(non_terminal_count);
+    for (const Production& prod : productions) {
+        int left = prod.lhs - terminal_count;
+        for (int symbol : prod.rhs) {
+            if (symbol < terminal_count) {
+                first_sets[left].insert(symbol);
+                break;
             }
-            
-            // 更新FIRST(left)
-            for (const string& terminal : right_first) {
-                if (first_sets[left].insert(terminal).second) {
-                    changed = true;
-                }
+            dependents[symbol - terminal_count].push_back(left);
+            if (!nullable[symbol - terminal_count]) break;
+        }
+    }
+    propagate(first_sets, dependents);
+}
+
+// 沿依赖边把集合并入其后继，直到不再变化；每个集合改变后才重新入队
+void LRParser::propagate(vector<SymbolSet>& sets, const vector<vector<int>>& dependents) {
+    vector<int> worklist;
+    vector<bool> queued(sets.size(), true);
+    for (int i = sets.size() - 1; i >= 0; i--) {
+        worklist.push_back(i);
+    }
+    while (!worklist.empty()) {
+        int from = worklist.back();
+        worklist.pop_back();
+        queued[from] = false;
+        for (int to : dependents[from]) {
+            if (to != from && sets[to].unite(sets[from]) && !queued[to]) {
+                queued[to] = true;
+                worklist.push_back(to);
             }
         }
     }
 }
 
 // 计算FOLLOW集合
+// 从右向左扫描每个右部，后缀的FIRST集合直接并入 FOLLOW(X)；后缀可空时连一条 left -> X 的依赖边，再用工作表传播
 void LRParser::computeFollowSets() {
-    // 为每个非终结符初始化空的FOLLOW集合
-    for (const string& non_terminal : non_terminals) {
-        follow_sets[non_terminal] = set<string>();
-    }
-    
+    int non_terminal_count = vocab.size() - terminal_count;
+    follow_sets.assign(non_terminal_count, SymbolSet(terminal_count));
+
     // 将EOF添加到开始符号的FOLLOW集合中
-    follow_sets[start_symbol].insert("EOF");
-    
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        
-        for (const Production& production : productions) {
-            const string& left = production.left;
-            const vector<string>& right = production.right;
-            
-            // 遍历右部的每个符号
-            for (size_t i = 0; i < right.size(); i++) {
-                const string& current = right[i];
-                
-                // 只处理非终结符
-                if (non_terminals.find(current) == non_terminals.end()) {
-                    continue;
-                }
-                
-                // 如果current是右部最后一个符号，或者current后面的所有符号都可以推导出ε
-                bool is_last_or_nullable = true;
-                if (i == right.size() - 1) {
-                    // 如果current是右部最后一个符号，则将FOLLOW(left)添加到FOLLOW(current)
-                    for (const string& symbol : follow_sets[left]) {
-                        if (follow_sets[current].insert(symbol).second) {
-                            changed = true;
-                        }
-                    }
-                } else {
-                    // 考虑current后面的符号
-                    set<string> trailer_first;
-                    bool all_nullable = true;
-                    
-                    for (size_t j = i + 1; j < right.size(); j++) {
-                        const string& next = right[j];
-                        
-                        // 如果next是终结符
-                        if (terminals.find(next) != terminals.end()) {
-                            trailer_first.insert(next);
-                            all_nullable = false;
-                            break;
-                        } else {
-                            // 如果next是非终结符
-                            const set<string>& next_first = first_sets[next];
-                            
-                            // 添加除ε以外的所有符号
-                            for (const string& terminal : next_first) {
-                                if (terminal != "ε") {
-                                    trailer_first.insert(terminal);
-                                }
-                            }
-                            
-                            // 如果next不可以推导出ε，则停止
-                            if (next_first.find("ε") == next_first.end()) {
-                                all_nullable = false;
-                                break;
-                            }
-                        }
-                    }
-                    
-                    // 将计算得到的FIRST集合添加到FOLLOW(current)
-                    for (const string& symbol : trailer_first) {
-                        if (follow_sets[current].insert(symbol).second) {
-                            changed = true;
-                        }
-                    }
-                    
-                    // 如果后面的所有符号都可以推导出ε，则将FOLLOW(left)添加到FOLLOW(current)
-                    if (all_nullable) {
-                        for (const string& symbol : follow_sets[left]) {
-                            if (follow_sets[current].insert(symbol).second) {
-                                changed = true;
-                            }
-                        }
-                    }
-                }
+    follow_sets[vocab.find(start_symbol) - terminal_count].insert(vocab.find("EOF"));
+
+    vector<vector<int>> dependents(non_terminal_count);
+    for (const Production& prod : productions) {
+        int left = prod.lhs - terminal_count;
+        SymbolSet trailer(terminal_count);      // 当前符号之后的后缀的FIRST集合
+        bool trailer_nullable = true;           // 后缀是否可空
+        for (int i = prod.rhs.size() - 1; i >= 0; i--) {
+            int symbol = prod.rhs[i];
+            if (symbol < terminal_count) {
+                trailer = SymbolSet(terminal_count);
+                trailer.insert(symbol);
+                trailer_nullable = false;
+                continue;
+            }
+            int current = symbol - terminal_count;
+            follow_sets[current].unite(trailer);
+            if (trailer_nullable) {
+                dependents[left].push_back(current);
+            }
+            if (nullable[current]) {
+                trailer.unite(first_sets[current]);
+            } else {
+                trailer = first_sets[current];
+                trailer_nullable = false;
             }
         }
     }
+    propagate(follow_sets, dependents);
 }
 
 // 构建SLR(1)分析表
 void LRParser::buildSLRTable() {
     has_conflicts = false;
+    conflict_count = 0;
     int state_count = canonical_collection.size();
     
     // 初始化ACTION表和GOTO表
     action_table.resize(state_count, vector<ActionEntry>(terminals.size(), ActionEntry()));
-    goto_table.resize(state_count);
-    
-    // 创建终结符到索引的映射
-    map<string, int> terminal_indices;
-    int idx = 0;
-    for (const string& terminal : terminals) {
-        terminal_indices[terminal] = idx++;
-    }
+    goto_table.resize(state_count, vector<int>(non_terminals.size(), -1));
     
     // 遍历每个状态
     for (int state = 0; state < state_count; state++) {
-        const ItemSet& item_set = canonical_collection[state];
+        buildSLRRow(state);
+    }
+}
+
+// 由已展开的项集构造分析表中状态 state 的ACTION行和GOTO行，归约的向前看符号为左部的FOLLOW集合
+void LRParser::buildSLRRow(int state) {
+    buildRow(state, [this](int production) -> const SymbolSet& {
+        return follow_sets[productions[production].lhs - terminal_count];
+    });
+}
+
+// 由已展开的项集构造分析表中状态 state 的ACTION行和GOTO行
+// lookahead(产生式编号) 给出该产生式在此状态归约时的向前看符号集合
+template <typename Lookahead>
+void LRParser::buildRow(int state, Lookahead lookahead) {
+    const ItemSet& item_set = canonical_collection[state];
+    
+    // 处理移进和接受操作
+    for (const auto& transition : item_set.goto_transitions) {
+        int symbol = transition.first;
+        int next_state = transition.second;
         
-        // 处理移进和接受操作
-        for (const auto& transition : item_set.goto_transitions) {
-            const string& symbol = transition.first;
-            int next_state = transition.second;
+        // 如果是终结符，则添加移进操作
+        if (symbol < terminal_count) {
+            int col = symbol;
+            
+            // 检查是否已经有操作
+            if (action_table[state][col].type == REDUCE) {
+                //cout << "冲突：状态 " << state << " 在输入 " << symbol << " 上有S/R冲突，自动移进解决" << endl;
+                conflict_count++;
+                action_table[state][col] = ActionEntry(SHIFT, next_state);
+                continue;
+            }
+            if (action_table[state][col].type != ERR) {
+                has_conflicts = true;
+                conflict_count++;
+                //cout << "冲突：状态 " << state << " 在输入 " << symbol << " 上有多个操作" << endl;
+            }
             
-            // 如果是终结符，则添加移进操作
-            if (terminals.find(symbol) != terminals.end()) {
-                int col = terminal_indices[symbol];
+            action_table[state][col] = ActionEntry(SHIFT, next_state);
+        }
+        // 如果是非终结符，则添加GOTO操作
+        else {
+            goto_table[state][symbol - terminal_count] = next_state;
+        }
+    }
+    
+    // 处理归约和接受操作
+    for (const Item& item : item_set.items) {
+        const Production& prod = productions[item.production];
+        // 如果点在产生式右部末尾，则添加归约操作
+        if (item.dot_position == (int)prod.rhs.size()) {
+            // 特殊情况：如果是增广文法的起始产生式，则添加接受操作
+            if (prod.left == start_symbol && prod.id == 0) {
+                int col = vocab.find("EOF");
                 
                 // 检查是否已经有操作
-                if (action_table[state][col].type == REDUCE) {
-                    //cout << "冲突：状态 " << state << " 在输入 " << symbol << " 上有S/R冲突，自动移进解决" << endl;
-                    action_table[state][col] = ActionEntry(SHIFT, next_state);
-                    continue;
-                }
                 if (action_table[state][col].type != ERR) {
                     has_conflicts = true;
-                    //cout << "冲突：状态 " << state << " 在输入 " << symbol << " 上有多个操作" << endl;
+                    conflict_count++;
+                    //cout << "冲突：状态 " << state << " 在输入 EOF 上有多个操作" << endl;
                 }
                 
-                action_table[state][col] = ActionEntry(SHIFT, next_state);
-            }
-            // 如果是非终结符，则添加GOTO操作
-            else if (non_terminals.find(symbol) != non_terminals.end()) {
-                goto_table[state][symbol] = next_state;
-            }
-        }
-        
-        // 处理归约和接受操作
-        for (const Item& item : item_set.items) {
-            // 如果点在产生式右部末尾，则添加归约操作
-            if (item.dot_position == item.production.right.size()) {
-                // 特殊情况：如果是增广文法的起始产生式，则添加接受操作
-                if (item.production.left == start_symbol && item.production.id == 0) {
-                    int col = terminal_indices["EOF"];
-                    
+                action_table[state][col] = ActionEntry(ACCEPT, prod.id);
+            } else {
+                // 对于每个向前看终结符，添加归约操作
+                lookahead(prod.id).forEach([&](int col) {
+                    if (action_table[state][col].type == SHIFT) {
+                        // 产生式和输入符号都声明了优先级时，优先级高者胜出，相同时左结合归约、右结合移进
+                        int rule = production_precedence[prod.id];
+                        if (rule != 0 && precedence[col] != 0) {
+                            if (rule > precedence[col] || (rule == precedence[col] && !right_assoc[col])) {
+                                action_table[state][col] = ActionEntry(REDUCE, prod.id);
+                            }
+                            return;
+                        }
+                        //cout << "冲突：状态 " << state << " 在输入 " << vocab.name(col) << " 上S/R冲突, 默认进行移进操作解决" << endl;
+                        conflict_count++;
+                        return;
+                    }
                     // 检查是否已经有操作
                     if (action_table[state][col].type != ERR) {
                         has_conflicts = true;
-                        //cout << "冲突：状态 " << state << " 在输入 EOF 上有多个操作" << endl;
+                        conflict_count++;
+                        //cout << "冲突：状态 " << state << " 在输入 " << vocab.name(col) << " 上有多个操作" << endl;
                     }
                     
-                    action_table[state][col] = ActionEntry(ACCEPT, item.production.id);
-                } else {
-                    // 对于每个在FOLLOW(item.production.left)中的终结符，添加归约操作
-                    for (const string& terminal : follow_sets[item.production.left]) {
-                        if (terminals.find(terminal) != terminals.end()) {
-                            int col = terminal_indices[terminal];
-                            if (action_table[state][col].type == SHIFT) {
-                                //cout << "冲突：状态 " << state << " 在输入 " << terminal << " 上S/R冲突, 默认进行移进操作解决" << endl;
-                                continue;
-                            }
-                            // 检查是否已经有操作
-                            if (action_table[state][col].type != ERR) {
-                                has_conflicts = true;
-                                //cout << "冲突：状态 " << state << " 在输入 " << terminal << " 上有多个操作" << endl;
-                            }
-                            
-                            action_table[state][col] = ActionEntry(REDUCE, item.production.id);
-                        }
+                    action_table[state][col] = ActionEntry(REDUCE, prod.id);
+                });
+            }
+        }
+    }
+}
+
+// DeRemer-Pennello 的 digraph 算法：F(x) = sets[x] ∪ ⋃{F(y) | x R y}
+// 按深度优先遍历关系图，同一强连通分量中的结点得到相同的集合，每条边只并一次
+void LRParser::digraph(vector<SymbolSet>& sets, const vector<vector<int>>& relation) {
+    const int done = INT_MAX;
+    vector<int> depth(sets.size(), 0);
+    vector<int> stack;
+    // 显式栈保存待遍历的结点：结点、进栈时的深度、下一条待访问的边
+    struct Frame {
+        int node;
+        int depth;
+        size_t edge;
+    };
+    vector<Frame> frames;
+    for (size_t root = 0; root < sets.size(); root++) {
+        if (depth[root] != 0) continue;
+        stack.push_back(root);
+        depth[root] = stack.size();
+        frames.push_back(Frame{(int)root, depth[root], 0});
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            int x = frame.node;
+            if (frame.edge < relation[x].size()) {
+                int y = relation[x][frame.edge++];
+                if (depth[y] == 0) {
+                    stack.push_back(y);
+                    depth[y] = stack.size();
+                    frames.push_back(Frame{y, depth[y], 0});
+                    continue;
+                }
+                depth[x] = min(depth[x], depth[y]);
+                sets[x].unite(sets[y]);
+                continue;
+            }
+            // x 是强连通分量的根：分量中的结点出栈，集合与根相同
+            if (depth[x] == frame.depth) {
+                while (true) {
+                    int top = stack.back();
+                    stack.pop_back();
+                    depth[top] = done;
+                    if (top == x) break;
+                    sets[top] = sets[x];
+                }
+            }
+            frames.pop_back();
+            // 回到父结点，把子结点的结果并入父结点
+            if (!frames.empty()) {
+                int parent = frames.back().node;
+                depth[parent] = min(depth[parent], depth[x]);
+                sets[parent].unite(sets[x]);
+            }
+        }
+    }
+}
+
+// 构建LALR(1)分析表，与SLR(1)共用LR(0)项集族，只是归约的向前看符号不同
+// 按 DeRemer-Pennello 方法：对每个非终结符转移 (p, A)
+//   DR(p, A)   = goto(p, A) 上可移进的终结符
+//   (p, A) reads (r, C)      当 r = goto(p, A) 且 C 可空
+//   (p, A) includes (p', B)  当 B → βAγ，γ 可空且 p' 经 β 到达 p
+//   (q, B → ω) lookback (p', B)  当 p' 经 ω 到达 q
+// Read = digraph(reads, DR)，Follow = digraph(includes, Read)，LA(q, B → ω) 为 lookback 的 Follow 之并
+void LRParser::buildLALRTable() {
+    has_conflicts = false;
+    conflict_count = 0;
+    int state_count = canonical_collection.size();
+    int symbol_count = terminal_count + non_terminals.size();
+    int non_terminal_count = non_terminals.size();
+
+    // 全部转移 state * symbol_count + symbol -> 目标状态
+    vector<int> go(state_count * symbol_count, -1);
+    for (int state = 0; state < state_count; state++) {
+        for (const auto& transition : canonical_collection[state].goto_transitions) {
+            go[state * symbol_count + transition.first] = transition.second;
+        }
+    }
+
+    // 非终结符转移编号，(p, A) 的编号存放在 index[p * non_terminal_count + A]
+    vector<int> index(state_count * non_terminal_count, -1);
+    vector<pair<int, int>> transitions;
+    for (int state = 0; state < state_count; state++) {
+        for (const auto& transition : canonical_collection[state].goto_transitions) {
+            if (transition.first >= terminal_count) {
+                index[state * non_terminal_count + transition.first - terminal_count] = transitions.size();
+                transitions.emplace_back(state, transition.first);
+            }
+        }
+    }
+    // 文法未增广：把接受看作 S' → start EOF，在 (0, start) 上读入EOF
+    int start = vocab.find(start_symbol);
+    int eof = vocab.find("EOF");
+    int& start_transition = index[start - terminal_count];
+    if (start_transition == -1) {
+        start_transition = transitions.size();
+        transitions.emplace_back(0, start);
+    }
+
+    vector<SymbolSet> sets(transitions.size(), SymbolSet(terminal_count));
+    vector<vector<int>> reads(transitions.size());
+    for (size_t t = 0; t < transitions.size(); t++) {
+        int target = go[transitions[t].first * symbol_count + transitions[t].second];
+        if (target == -1) continue;
+        for (const auto& transition : canonical_collection[target].goto_transitions) {
+            int symbol = transition.first;
+            if (symbol < terminal_count) {
+                sets[t].insert(symbol);
+            } else if (nullable[symbol - terminal_count]) {
+                reads[t].push_back(index[target * non_terminal_count + symbol - terminal_count]);
+            }
+        }
+    }
+    sets[start_transition].insert(eof);
+    digraph(sets, reads);
+
+    // 从每个转移 (p', B) 出发沿 B 的每个右部走一遍，得到 includes 和 lookback
+    vector<vector<int>> includes(transitions.size());
+    vector<vector<pair<int, int>>> lookback(state_count);   // 状态 -> (产生式, 转移)
+    for (size_t t = 0; t < transitions.size(); t++) {
+        int left = transitions[t].second;
+        for (int p : productions_by_left[left - terminal_count]) {
+            const vector<int>& rhs = productions[p].rhs;
+            int state = transitions[t].first;
+            for (size_t i = 0; i < rhs.size() && state != -1; i++) {
+                int symbol = rhs[i];
+                if (symbol >= terminal_count) {
+                    size_t k = i + 1;
+                    while (k < rhs.size() && rhs[k] >= terminal_count && nullable[rhs[k] - terminal_count]) k++;
+                    if (k == rhs.size()) {
+                        includes[index[state * non_terminal_count + symbol - terminal_count]].push_back(t);
                     }
                 }
+                state = go[state * symbol_count + symbol];
+            }
+            if (state != -1) {
+                lookback[state].emplace_back(p, t);
+            }
+        }
+    }
+    digraph(sets, includes);
+
+    // 每个状态中各完整项的向前看符号
+    vector<vector<pair<int, SymbolSet>>> lookaheads(state_count);
+    for (int state = 0; state < state_count; state++) {
+        for (const auto& entry : lookback[state]) {
+            auto found = find_if(lookaheads[state].begin(), lookaheads[state].end(), [&](const pair<int, SymbolSet>& la) {
+                return la.first == entry.first;
+            });
+            if (found == lookaheads[state].end()) {
+                lookaheads[state].emplace_back(entry.first, sets[entry.second]);
+            } else {
+                found->second.unite(sets[entry.second]);
             }
         }
     }
+
+    action_table.resize(state_count, vector<ActionEntry>(terminals.size(), ActionEntry()));
+    goto_table.resize(state_count, vector<int>(non_terminals.size(), -1));
+    SymbolSet none(terminal_count);
+    for (int state = 0; state < state_count; state++) {
+        buildRow(state, [&](int production) -> const SymbolSet& {
+            for (const auto& la : lookaheads[state]) {
+                if (la.first == production) return la.second;
+            }
+            return none;
+        });
+    }
 }
 
 // 辅助函数：修剪字符串两端的空白
@@ -479,28 +718,348 @@ vector<string> LRParser::tokenize(const string& str) {
 
 // 打印项
 string LRParser::itemToString(const Item& item) const {
-    string result = item.production.left + " → ";
+    const Production& prod = productions[item.production];
+    string result = prod.left + " → ";
     
-    for (size_t i = 0; i < item.production.right.size(); i++) {
-        if (i == item.dot_position) {
+    for (size_t i = 0; i < prod.right.size(); i++) {
+        if ((int)i == item.dot_position) {
             result += "· ";
         }
-        result += item.production.right[i] + " ";
+        result += prod.right[i] + " ";
     }
     
-    if (item.dot_position == item.production.right.size()) {
+    if (item.dot_position == (int)prod.right.size()) {
         result += "·";
     }
     
     return result;
 }
+void LRParser::buildLazyParser(const vector<string>& input) {
+    lazy = true;
+    parseGrammar(input);
+    computeFirstSets();
+    computeFollowSets();
+    prepareCollection();
+    has_conflicts = false;
+    materialize(0);
+}
+
+void LRParser::materialize(int state) {
+    if (closed[state]) {
+        return;
+    }
+    expandState(state);
+    // 新项集的行先置为出错，进入时再填写
+    action_table.resize(canonical_collection.size(), vector<ActionEntry>(terminal_count, ActionEntry()));
+    goto_table.resize(canonical_collection.size(), vector<int>(non_terminals.size(), -1));
+    buildSLRRow(state);
+}
+
 // 解析输入并构建SLR(1)分析表
 void LRParser::buildParser(const vector<string>& input) {
     parseGrammar(input);
     buildCanonicalCollection();
     computeFirstSets();
     computeFollowSets();
-    buildSLRTable();
+    if (lalr_tables) {
+        buildLALRTable();
+    } else {
+        buildSLRTable();
+    }
+    buildParseTable();
+}
+
+void LRParser::buildParseTable() {
+    if (fold_units) {
+        parse_table.build(action_table, foldUnitReductions(), comb_tables);
+    } else {
+        parse_table.build(action_table, goto_table, comb_tables);
+    }
+}
+
+// 若状态 s 的ACTION行只有按同一个单位产生式 A -> B 的归约、且没有GOTO转移，则从 t 经 B 进入 s 后
+// 必然立即归约并经 A 转移到 GOTO(t, A)。把 GOTO(t, B) 改为最终到达的状态，途经的单位产生式记在
+// unit_chains 中，由分析驱动在转移时对栈顶的语义值依次执行。s 的向前看符号包含 GOTO(t, A) 上全部
+// 有效的符号，因此出错的位置和信息不变
+vector<vector<int>> LRParser::foldUnitReductions() {
+    int state_count = action_table.size();
+    int non_terminal_count = non_terminals.size();
+
+    // 状态 -> 它唯一可做的单位归约，-1表示不是这样的状态
+    vector<int> unit_state(state_count, -1);
+    for (int state = 0; state < state_count; state++) {
+        int production = -1;
+        bool pure = true;
+        for (const ActionEntry& entry : action_table[state]) {
+            if (entry.type == ERR) continue;
+            if (entry.type != REDUCE || (production != -1 && entry.value != production)) {
+                pure = false;
+                break;
+            }
+            production = entry.value;
+        }
+        for (int target : goto_table[state]) {
+            if (target != -1) pure = false;
+        }
+        if (pure && production != -1 && productions[production].rhs.size() == 1 && productions[production].rhs[0] >= terminal_count) {
+            unit_state[state] = production;
+        }
+    }
+
+    vector<vector<int>> folded = goto_table;
+    unit_folds.assign(state_count * non_terminal_count, -1);
+    unit_chains.clear();
+    for (int state = 0; state < state_count; state++) {
+        for (int column = 0; column < non_terminal_count; column++) {
+            vector<int> chain;
+            int target = goto_table[state][column];
+            // 无环文法中单位归约链的长度不超过非终结符个数
+            while (target != -1 && unit_state[target] != -1 && (int)chain.size() < non_terminal_count) {
+                const Production& unit = productions[unit_state[target]];
+                int next = goto_table[state][unit.lhs - terminal_count];
+                if (next == -1) break;
+                chain.push_back(unit.id);
+                target = next;
+            }
+            if (chain.empty()) continue;
+            folded[state][column] = target;
+            unit_folds[state * non_terminal_count + column] = unit_chains.size();
+            unit_chains.push_back(chain);
+        }
+    }
+    return folded;
+}
+
+// 分析表缓存文件格式版本，构建算法或文件布局改变时递增
+static const char TABLE_CACHE_MAGIC[8] = {'L', 'C', 'S', 'L', 'R', 'T', 'B', '1'};
+
+// FNV-1a 64位哈希
+static uint64_t fnv1a(string_view data, uint64_t hash = 14695981039346656037ull) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 缓存文件读取游标，越界时置 ok 为 false
+struct CacheReader {
+    string_view data;
+    size_t pos;
+    bool ok;
+
+    uint32_t u32() {
+        uint32_t value = 0;
+        if (pos + sizeof(value) > data.size()) {
+            ok = false;
+            return 0;
+        }
+        memcpy(&value, data.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return value;
+    }
+
+    uint64_t u64() {
+        uint64_t low = u32();
+        return low | (uint64_t)u32() << 32;
+    }
+
+    string str() {
+        uint32_t size = u32();
+        if (!ok || pos + size > data.size()) {
+            ok = false;
+            return "";
+        }
+        string value(data.substr(pos, size));
+        pos += size;
+        return value;
+    }
+};
+
+// 缓存文件写入缓冲
+struct CacheWriter {
+    string data;
+
+    void u32(uint32_t value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void u64(uint64_t value) {
+        u32((uint32_t)value);
+        u32((uint32_t)(value >> 32));
+    }
+
+    void str(const string& value) {
+        u32(value.size());
+        data += value;
+    }
+};
+
+uint64_t LRParser::grammarHash(const vector<string>& input) {
+    uint64_t hash = fnv1a(string_view(TABLE_CACHE_MAGIC, sizeof(TABLE_CACHE_MAGIC)));
+    for (const string& line : input) {
+        hash = fnv1a(line, hash);
+        hash = fnv1a("\n", hash);
+    }
+    return hash;
+}
+
+void LRParser::buildParser(const vector<string>& input, const string& cache_file) {
+    // 两种分析表共用一个缓存文件，以表的种类区分
+    uint64_t hash = lalr_tables ? fnv1a("LALR", grammarHash(input)) : grammarHash(input);
+    if (loadTables(cache_file, hash)) {
+        buildParseTable();
+        return;
+    }
+    buildParser(input);
+    saveTables(cache_file, hash);
+}
+
+// 文件布局：魔数、文法哈希、载荷哈希、载荷
+// 载荷：符号数、终结符数、各符号名；产生式数、各产生式的左部与右部编号；状态数、ACTION表、GOTO表
+bool LRParser::loadTables(const string& cache_file, uint64_t grammar_hash) {
+    auto file = SourceBuffer::load(cache_file);
+    if (!file) {
+        return false;
+    }
+    string_view data = file->view();
+    size_t header = sizeof(TABLE_CACHE_MAGIC) + 16;
+    if (data.size() < header || data.substr(0, sizeof(TABLE_CACHE_MAGIC)) != string_view(TABLE_CACHE_MAGIC, sizeof(TABLE_CACHE_MAGIC))) {
+        return false;
+    }
+    CacheReader in{data, sizeof(TABLE_CACHE_MAGIC), true};
+    if (in.u64() != grammar_hash || in.u64() != fnv1a(data.substr(header))) {
+        return false;
+    }
+
+    // 先读入并检查全部内容，确认无误后才修改分析器
+    uint32_t symbol_count = in.u32();
+    uint32_t term_count = in.u32();
+    if (!in.ok || term_count > symbol_count || symbol_count > data.size()) {
+        return false;
+    }
+    vector<string> names(symbol_count);
+    for (string& name : names) {
+        name = in.str();
+    }
+
+    uint32_t production_count = in.u32();
+    if (!in.ok || production_count == 0 || production_count > data.size()) {
+        return false;
+    }
+    vector<Production> prods(production_count);
+    for (uint32_t p = 0; p < production_count && in.ok; p++) {
+        prods[p].id = p;
+        prods[p].lhs = in.u32();
+        uint32_t size = in.u32();
+        if (!in.ok || prods[p].lhs < (int)term_count || prods[p].lhs >= (int)symbol_count || size > data.size()) {
+            return false;
+        }
+        for (uint32_t k = 0; k < size; k++) {
+            uint32_t symbol = in.u32();
+            if (symbol >= symbol_count) {
+                return false;
+            }
+            prods[p].rhs.push_back(symbol);
+        }
+    }
+
+    uint32_t state_count = in.u32();
+    if (!in.ok || state_count == 0 || (uint64_t)state_count * symbol_count > data.size()) {
+        return false;
+    }
+    vector<vector<ActionEntry>> actions(state_count, vector<ActionEntry>(term_count));
+    for (auto& row : actions) {
+        for (ActionEntry& entry : row) {
+            uint32_t type = in.u32();
+            int value = (int)in.u32();
+            bool valid = (type == SHIFT && value >= 0 && value < (int)state_count) ||
+                         ((type == REDUCE || type == ACCEPT) && value >= 0 && value < (int)production_count) ||
+                         (type == ERR && value == -1);
+            if (!valid) {
+                return false;
+            }
+            entry = ActionEntry((ActionType)type, value);
+        }
+    }
+    vector<vector<int>> gotos(state_count, vector<int>(symbol_count - term_count));
+    for (auto& row : gotos) {
+        for (int& entry : row) {
+            entry = (int)in.u32();
+            if (entry < -1 || entry >= (int)state_count) {
+                return false;
+            }
+        }
+    }
+    if (!in.ok || in.pos != data.size()) {
+        return false;
+    }
+
+    if (vocab.size() != 0) {
+        throw runtime_error("Grammar symbols must be numbered before any other token.");
+    }
+    for (uint32_t i = 0; i < symbol_count; i++) {
+        vocab.intern(names[i]);
+        (i < term_count ? terminals : non_terminals).insert(names[i]);
+    }
+    terminal_count = term_count;
+    for (Production& prod : prods) {
+        prod.left = names[prod.lhs];
+        for (int symbol : prod.rhs) {
+            prod.right.push_back(names[symbol]);
+        }
+    }
+    productions = std::move(prods);
+    start_symbol = productions[0].left;
+    action_table = std::move(actions);
+    goto_table = std::move(gotos);
+    return true;
+}
+
+void LRParser::saveTables(const string& cache_file, uint64_t grammar_hash) const {
+    CacheWriter out;
+    out.u32(vocab.size());
+    out.u32(terminal_count);
+    for (size_t i = 0; i < vocab.size(); i++) {
+        out.str(vocab.name(i));
+    }
+    out.u32(productions.size());
+    for (const Production& prod : productions) {
+        out.u32(prod.lhs);
+        out.u32(prod.rhs.size());
+        for (int symbol : prod.rhs) {
+            out.u32(symbol);
+        }
+    }
+    out.u32(action_table.size());
+    for (const auto& row : action_table) {
+        for (const ActionEntry& entry : row) {
+            out.u32(entry.type);
+            out.u32(entry.value);
+        }
+    }
+    for (const auto& row : goto_table) {
+        for (int entry : row) {
+            out.u32(entry);
+        }
+    }
+
+    CacheWriter header;
+    header.data.assign(TABLE_CACHE_MAGIC, sizeof(TABLE_CACHE_MAGIC));
+    header.u64(grammar_hash);
+    header.u64(fnv1a(out.data));
+
+    // 先写临时文件再改名，避免并发运行的编译器读到写了一半的缓存
+    string tmp = cache_file + ".tmp" + to_string(getpid());
+    ofstream file(tmp, ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    file << header.data << out.data;
+    file.close();
+    if (!file || rename(tmp.c_str(), cache_file.c_str()) != 0) {
+        remove(tmp.c_str());
+    }
 }
 
 // 打印项集族
@@ -520,7 +1079,7 @@ void LRParser::printCanonicalCollection() const {
             cout << "    (无)" << endl;
         } else {
             for (const auto& transition : canonical_collection[i].goto_transitions) {
-                cout << "    " << transition.first << " → I" << transition.second << endl;
+                cout << "    " << vocab.name(transition.first) << " → I" << transition.second << endl;
             }
         }
         
@@ -533,12 +1092,17 @@ void LRParser::printFirstSets() const {
     cout << "FIRST集合:" << endl;
     for (const string& non_terminal : non_terminals) {
         cout << "FIRST(" << non_terminal << ") = { ";
-        const set<string>& first = first_sets.at(non_terminal);
+        int index = vocab.find(non_terminal) - terminal_count;
         bool first_item = true;
-        for (const string& symbol : first) {
+        first_sets[index].forEach([&](int symbol) {
             if (!first_item) cout << ", ";
-            cout << symbol;
+            cout << vocab.name(symbol);
             first_item = false;
+        });
+        // ε 的名字排在所有终结符之后
+        if (nullable[index]) {
+            if (!first_item) cout << ", ";
+            cout << "ε";
         }
         cout << " }" << endl;
     }
@@ -550,13 +1114,12 @@ void LRParser::printFollowSets() const {
     cout << "FOLLOW集合:" << endl;
     for (const string& non_terminal : non_terminals) {
         cout << "FOLLOW(" << non_terminal << ") = { ";
-        const set<string>& follow = follow_sets.at(non_terminal);
         bool first_item = true;
-        for (const string& symbol : follow) {
+        follow_sets[vocab.find(non_terminal) - terminal_count].forEach([&](int symbol) {
             if (!first_item) cout << ", ";
-            cout << symbol;
+            cout << vocab.name(symbol);
             first_item = false;
-        }
+        });
         cout << " }" << endl;
     }
     cout << "----------------" << endl;
@@ -624,8 +1187,8 @@ void LRParser::printSLRTable() const {
         
         // 打印GOTO表部分
         for (const string& non_terminal : non_terminal_list) {
-            auto it = goto_table[state].find(non_terminal);
-            string goto_str = (it != goto_table[state].end()) ? to_string(it->second) : "";
+            int next_state = goto_table[state][vocab.find(non_terminal) - terminal_count];
+            string goto_str = (next_state != -1) ? to_string(next_state) : "";
             
             cout << " | " << setw(8) << goto_str;
         }
@@ -697,8 +1260,8 @@ void LRParser::exportSLRTableToCSV(const string& filename) const {
         
         // 写入GOTO表部分
         for (const string& non_terminal : non_terminal_list) {
-            auto it = goto_table[state].find(non_terminal);
-            string goto_str = (it != goto_table[state].end()) ? to_string(it->second) : "";
+            int next_state = goto_table[state][vocab.find(non_terminal) - terminal_count];
+            string goto_str = (next_state != -1) ? to_string(next_state) : "";
             
             file << "," << goto_str;
         }
@@ -726,199 +1289,486 @@ void LRParser::printProductions() const {
     cout << "----------------" << endl;
 }
 
-ParseTreeNode* LRParser::parseTokens(const vector<Token>& tokens, bool check) {
-    // 清理之前的解析树
-    if (parse_tree_root) {
-        delete parse_tree_root;
-        parse_tree_root = nullptr;
+// 产生式的文本形式，用于生成代码的注释
+static string productionText(const Production& prod) {
+    string text = prod.left + " ->";
+    if (prod.right.empty()) {
+        text += " ε";
     }
-    
+    for (const string& symbol : prod.right) {
+        text += " " + symbol;
+    }
+    return text;
+}
+
+// 生成代码中右部语义值在值栈中的起始位置
+static string rhsPointer(int count) {
+    return count == 0 ? "values.data() + values.size()" : "values.data() + values.size() - " + to_string(count);
+}
+
+void LRParser::writeDirectParser(ostream& out, const string& name, uint64_t grammar_hash) const {
+    int state_count = action_table.size();
+    out << "// 由 parsegen 根据文法生成的直接编码SLR(1)分析器，请勿手动修改\n";
+    out << "#ifndef " << name << "_HPP\n";
+    out << "#define " << name << "_HPP\n\n";
+    out << "#include <cstdint>\n";
+    out << "#include <vector>\n";
+    out << "#include \"parserule.hpp\"\n";
+    out << "#include \"token.hpp\"\n\n";
+
+    out << "struct " << name << " {\n";
+    out << "    // 生成时文法文本的哈希，与 LRParser::grammarHash 相同时符号和产生式编号才一致\n";
+    out << "    static constexpr uint64_t GRAMMAR_HASH = 0x" << hex << grammar_hash << dec << "ull;\n";
+    out << "    static constexpr int TERMINAL_COUNT = " << terminal_count << ";\n";
+    out << "    static constexpr int EOF_KIND = " << vocab.find("EOF") << ";\n\n";
+
+    // 每个被归约的产生式生成一个归约函数，GOTO转移按归约后的栈顶状态 switch 分派
+    vector<bool> reduced(productions.size(), false);
+    for (const auto& row : action_table) {
+        for (const ActionEntry& entry : row) {
+            if (entry.type == REDUCE) reduced[entry.value] = true;
+        }
+    }
+    for (const Production& prod : productions) {
+        if (!reduced[prod.id]) continue;
+        int pop_count = prod.rhs.size();
+        out << "    // " << productionText(prod) << "\n";
+        out << "    template <typename Value, typename Actions>\n";
+        out << "    static bool reduce" << prod.id << "(std::vector<int>& states, std::vector<Value>& values, Actions& actions, const Production* productions) {\n";
+        out << "        Value value = actions.reduce(productions[" << prod.id << "], " << rhsPointer(pop_count) << ");\n";
+        if (pop_count > 0) {
+            out << "        states.resize(states.size() - " << pop_count << ");\n";
+            out << "        values.resize(values.size() - " << pop_count << ");\n";
+        }
+        out << "        values.push_back(std::move(value));\n";
+        out << "        switch (states.back()) {\n";
+        // (到达的状态, 折叠的单位归约链) -> 归约后的栈顶状态
+        map<pair<int, int>, vector<int>> targets;
+        for (int state = 0; state < state_count; state++) {
+            int target = goto_table[state][prod.lhs - terminal_count];
+            if (target == -1) continue;
+            int fold = unit_folds.empty() ? -1 : unit_folds[state * non_terminals.size() + prod.lhs - terminal_count];
+            if (fold != -1) {
+                target = goto_table[state][productions[unit_chains[fold].back()].lhs - terminal_count];
+            }
+            targets[{target, fold}].push_back(state);
+        }
+        for (const auto& [target, sources] : targets) {
+            for (int state : sources) {
+                out << "        case " << state << ":\n";
+            }
+            if (target.second != -1) {
+                for (int unit : unit_chains[target.second]) {
+                    out << "            // 折叠 " << productionText(productions[unit]) << "\n";
+                    out << "            values.back() = actions.reduce(productions[" << unit << "], &values.back());\n";
+                }
+            }
+            out << "            states.push_back(" << target.first << ");\n";
+            out << "            return true;\n";
+        }
+        out << "        default:\n";
+        out << "            return false;\n";
+        out << "        }\n";
+        out << "    }\n\n";
+    }
+
+    out << "    // 分析驱动：每个状态是一个按记号编号 switch 分派的代码块，语义值的构造和释放与表驱动分析相同\n";
+    out << "    template <typename TokenSource, typename Actions, typename Report>\n";
+    out << "    static typename Actions::Value parse(TokenSource& input, Actions& actions, const Production* productions, Report& report) {\n";
+    out << "        using Value = typename Actions::Value;\n";
+    out << "        std::vector<int> states;\n";
+    out << "        std::vector<Value> values;\n";
+    out << "        auto fail = [&]() {\n";
+    out << "            for (Value& value : values) {\n";
+    out << "                actions.discard(value);\n";
+    out << "            }\n";
+    out << "            return Value{};\n";
+    out << "        };\n";
+    out << "        states.push_back(0);\n";
+    out << "        const Token* token = &input.next();\n";
+    out << "        bool panick = false;\n";
+    out << "        while (true) {\n";
+    out << "            int kind = token->getKind();\n";
+    out << "            if (kind < 0 || kind >= TERMINAL_COUNT) {\n";
+    out << "                report.unknown(*token);\n";
+    out << "                token = &input.next();\n";
+    out << "                continue;\n";
+    out << "            }\n";
+    out << "            switch (states.back()) {\n";
+    for (int state = 0; state < state_count; state++) {
+        out << "            case " << state << ":\n";
+        out << "                switch (kind) {\n";
+        // 动作相同的记号合并为一组 case
+        map<pair<int, int>, vector<int>> groups;
+        for (int terminal = 0; terminal < terminal_count; terminal++) {
+            const ActionEntry& entry = action_table[state][terminal];
+            if (entry.type != ERR) groups[{entry.type, entry.value}].push_back(terminal);
+        }
+        for (const auto& [action, kinds] : groups) {
+            for (int kind : kinds) {
+                out << "                case " << kind << ": // " << vocab.name(kind) << "\n";
+            }
+            if (action.first == SHIFT) {
+                out << "                    states.push_back(" << action.second << ");\n";
+                out << "                    goto shift;\n";
+            } else if (action.first == REDUCE) {
+                out << "                    panick = false;\n";
+                out << "                    if (!reduce" << action.second << "(states, values, actions, productions)) report.gotoMissing(*token);\n";
+                out << "                    continue;\n";
+            } else {
+                const Production& prod = productions[action.second];
+                out << "                {\n";
+                out << "                    // 接受：" << productionText(prod) << "\n";
+                out << "                    Value root = actions.reduce(productions[" << prod.id << "], " << rhsPointer(prod.rhs.size()) << ");\n";
+                if (!prod.rhs.empty()) {
+                    out << "                    values.resize(values.size() - " << prod.rhs.size() << ");\n";
+                }
+                out << "                    fail();\n";
+                out << "                    return root;\n";
+                out << "                }\n";
+            }
+        }
+        out << "                default:\n";
+        out << "                    goto error;\n";
+        out << "                }\n";
+    }
+    out << "            default:\n";
+    out << "                goto error;\n";
+    out << "            }\n";
+    out << "        shift:\n";
+    out << "            panick = false;\n";
+    out << "            values.push_back(actions.shift(*token));\n";
+    out << "            if (kind == EOF_KIND) return fail();\n";
+    out << "            token = &input.next();\n";
+    out << "            continue;\n";
+    out << "        error:\n";
+    out << "            if (!panick) report.error(*token);\n";
+    out << "            panick = true;\n";
+    out << "            if (kind == EOF_KIND) return fail();\n";
+    out << "            token = &input.next();\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "};\n\n";
+    out << "#endif\n";
+}
+
+// 不输出分析过程的跟踪策略，各钩子均为空，编译后分析循环中不含任何输出
+struct NoTrace {
+    void notBuilt() {}
+    void begin() {}
+    void step(int, const Token&) {}
+    void unknown(const std::string&) {}
+    void shift(int) {}
+    void reduce(const Production&, bool) {}
+    void unit(const Production&) {}
+    void accept() {}
+    void gotoMissing(int, const Production&) {}
+    void error() {}
+    void endStep() {}
+};
+
+// 逐步输出状态、输入和动作的跟踪策略
+struct ParseTrace {
+    const Vocabulary& vocab;
+
+    void notBuilt() {
+        cout << "分析表尚未构建！" << endl;
+    }
+
+    void begin() {
+        cout << "开始解析..." << endl;
+    }
+
+    void step(int state, const Token& input) {
+        cout << "状态: " << state << ", 输入: " << input.toString(vocab);
+    }
+
+    void unknown(const std::string& name) {
+        cout << " -> 错误：未知的输入符号 " << name << endl;
+    }
+
+    void shift(int state) {
+        cout << " -> 移进到状态 " << state << endl;
+    }
+
+    void reduce(const Production& prod, bool accepting) {
+        cout << " -> 用产生式 " << prod.id << " 归约: " << prod.left << " -> ";
+        if (prod.right.empty()) {
+            if (accepting) cout << "ε";
+        } else {
+            for (const string& sym : prod.right) {
+                cout << sym << " ";
+            }
+        }
+        cout << endl;
+    }
+
+    void unit(const Production& prod) {
+        cout << "   -> 转移时折叠单位产生式 " << prod.id << ": " << prod.left << " -> " << prod.right[0] << endl;
+    }
+
+    void accept() {
+        cout << " -> 接受！解析成功。" << endl;
+    }
+
+    void gotoMissing(int state, const Production& prod) {
+        cout << "错误：GOTO表中找不到对应项 (" << state << ", " << prod.left << ")" << endl;
+    }
+
+    void error() {
+        cout << " -> 错误：无效操作" << endl;
+    }
+
+    void endStep() {
+        cout << endl;
+    }
+};
+
+// 查扁平分析表
+struct LRParser::FlatTable {
+    const ParseTable& table;
+
+    ActionEntry action(int state, int terminal) const {
+        return table.action(state, terminal);
+    }
+
+    int go(int state, int non_terminal) const {
+        return table.go(state, non_terminal);
+    }
+};
+
+// 查表前先构造状态所在的行；GOTO只在已进入过的状态上查，行已存在
+struct LRParser::LazyTable {
+    LRParser& parser;
+
+    ActionEntry action(int state, int terminal) const {
+        parser.materialize(state);
+        return parser.action_table[state][terminal];
+    }
+
+    int go(int state, int non_terminal) const {
+        return parser.goto_table[state][non_terminal - parser.terminal_count];
+    }
+};
+
+template <typename Trace, typename Table, typename TokenSource, typename Actions>
+typename Actions::Value LRParser::drive(TokenSource& input, Actions& actions, Trace& trace, Table& table) {
+    using Value = typename Actions::Value;
+
     // 检查分析表是否已构建
     if (action_table.empty()) {
-        if (!check)
-            cout << "分析表尚未构建！" << endl;
-        return nullptr;
+        trace.notBuilt();
+        return Value{};
     }
     
-    // 初始化解析栈和输入缓冲区
+    // 初始化解析栈
     vector<int> state_stack;                    // 状态栈
-    vector<ParseTreeNode*> symbol_stack;       // 符号栈（存储解析树节点）
-    vector<Token> input_buffer = tokens;      // 输入缓冲区
+    vector<Value> symbol_stack;                 // 符号栈（存储语义值）
+
+    // 分析失败时释放符号栈上的语义值
+    auto fail = [&]() {
+        for (Value& value : symbol_stack) {
+            actions.discard(value);
+        }
+        return Value{};
+    };
     
     // 初始状态
     state_stack.push_back(0);
-    int input_index = 0;
+    const Token* current_input = &input.next();  // 当前输入符号，在下一次取token前有效
     
-    // 创建终结符到索引的映射
-    map<string, int> terminal_indices;
-    int idx = 0;
-    for (const string& terminal : terminals) {
-        terminal_indices[terminal] = idx++;
-    }
-    if (!check)
-        cout << "开始解析..." << endl;
+    int eof_kind = vocab.find("EOF");
+    trace.begin();
     bool panick = false;
     while (true) {
         // 获取当前状态和输入符号
         int current_state = state_stack.back();
-        Token current_input = input_buffer[input_index];
-        if (!check)
-            cout << "状态: " << current_state << ", 输入: " << current_input.toString();
+        trace.step(current_state, *current_input);
         
-        // 检查输入符号是否在分析表中
-        if (terminal_indices.find(current_input.getId()) == terminal_indices.end()) {
-            if (!check)
-                cout << " -> 错误：未知的输入符号 " << current_input.getId() << endl;
-            err(current_input, "Unknown input token: " + current_input.getId());
-            input_index++;
+        // 检查输入符号是否在分析表中（终结符编号即列号）
+        int terminal_idx = current_input->getKind();
+        if (terminal_idx < 0 || terminal_idx >= terminal_count) {
+            trace.unknown(vocab.name(terminal_idx));
+            err(*current_input, "Unknown input token: " + vocab.name(terminal_idx));
+            current_input = &input.next();
             continue;
         }
         
         // 查找ACTION表中的操作
-        int terminal_idx = terminal_indices[current_input.getId()];
-        const ActionEntry& action = action_table[current_state][terminal_idx];
+        const ActionEntry action = table.action(current_state, terminal_idx);
         
         if (action.type == SHIFT) {
             // 移进操作
-            if (!check) cout << " -> 移进到状态 " << action.value << endl;
+            trace.shift(action.value);
             
             // 将输入符号移进栈中
             state_stack.push_back(action.value);
             panick = false;
             
-            // 创建终结符节点并压入符号栈
-            ParseTreeNode* terminal_node = new ParseTreeNode(current_input.getId(), current_input);
-            symbol_stack.push_back(terminal_node);
+            // 创建终结符的语义值并压入符号栈
+            symbol_stack.push_back(actions.shift(*current_input));
             
             // 移动输入指针
-            if (current_input.getId() == "EOF") return nullptr;
-            input_index++;
+            if (terminal_idx == eof_kind) return fail();
+            current_input = &input.next();
             
-        } else if (action.type == REDUCE) {
-            // 归约操作
+        } else if (action.type == REDUCE || action.type == ACCEPT) {
+            // 归约操作，接受时用开始符号的产生式归约
             const Production& reduction = productions[action.value];
-            if (!check) cout << " -> 用产生式 " << action.value << " 归约: " << reduction.left << " -> ";
-            if (reduction.right.empty()) {
-                //cout << "ε";
-            } else {
-                for (const string& sym : reduction.right) {
-                   if (!check) cout << sym << " ";
-                }
-            }
-            if (!check)cout << endl;
-            
-            // 创建非终结符节点
-            ParseTreeNode* non_terminal_node;
+            trace.reduce(reduction, action.type == ACCEPT);
             
-            // 弹出相应数量的状态和符号
-            int pop_count = reduction.right.size();
+            // 执行语义动作，右部的语义值在符号栈顶
+            int pop_count = reduction.rhs.size();
+            Value value = actions.reduce(reduction, symbol_stack.data() + symbol_stack.size() - pop_count);
             
-            // 处理空产生式的情况
-            if (reduction.right.empty()) {
-                // 对于空产生式，创建一个ε节点
-                non_terminal_node = new ParseTreeNode(reduction.left, Token(), Token());
-            } else {
-                // 收集归约涉及的符号节点（它们将成为新节点的子节点）
-                vector<ParseTreeNode*> reduction_nodes;
-                for (int i = 0; i < pop_count; i++) {
-                    state_stack.pop_back();
-                    reduction_nodes.push_back(symbol_stack.back());
-                    symbol_stack.pop_back();
-                }
+            // 弹出相应数量的状态和符号，压入左部的语义值
+            state_stack.resize(state_stack.size() - pop_count);
+            symbol_stack.resize(symbol_stack.size() - pop_count);
+            symbol_stack.push_back(std::move(value));
+            panick = false;
+
+            if (action.type == ACCEPT) {
+                trace.accept();
                 
-                // 由于栈是后进先出，需要反转子节点顺序
-                reverse(reduction_nodes.begin(), reduction_nodes.end());
-                non_terminal_node = new ParseTreeNode(reduction.left, reduction_nodes[0]->start, reduction_nodes[reduction_nodes.size()-1]->end);
-                non_terminal_node->children = reduction_nodes;
+                // 解析成功，返回开始符号的语义值
+                Value root = std::move(symbol_stack.back());
+                symbol_stack.pop_back();
+                fail();
+                return root;
             }
             
-            // 压入新的非终结符节点
-            symbol_stack.push_back(non_terminal_node);
-            panick = false;
-            
             // 查找GOTO表确定新状态
             int new_state = state_stack.back();
-            if (goto_table[new_state].find(reduction.left) != goto_table[new_state].end()) {
-                state_stack.push_back(goto_table[new_state][reduction.left]);
-            } else {
-                if (!check) cout << "错误：GOTO表中找不到对应项 (" << new_state << ", " << reduction.left << ")" << endl;
-                err(current_input, "Unknown Reduce Item near: " + current_input.getId());
-                continue;
-            }
-            
-        } else if (action.type == ACCEPT) {
-            // 接受操作
-            // 归约操作
-            const Production& reduction = productions[action.value];
-            if (!check) cout << " -> 用产生式 " << action.value << " 归约: " << reduction.left << " -> ";
-            if (reduction.right.empty()) {
-                if (!check) cout << "ε";
-            } else {
-                for (const string& sym : reduction.right) {
-                    if (!check) cout << sym << " ";
-                }
-            }
-            if (!check) cout << endl;
-            
-            // 创建非终结符节点
-            ParseTreeNode* non_terminal_node;
-            
-            // 弹出相应数量的状态和符号
-            int pop_count = reduction.right.size();
-            
-            // 处理空产生式的情况
-            if (reduction.right.empty()) {
-                // 对于空产生式，创建一个ε节点
-                non_terminal_node = new ParseTreeNode(reduction.left, Token(), Token());
-            } else {
-                // 收集归约涉及的符号节点（它们将成为新节点的子节点）
-                vector<ParseTreeNode*> reduction_nodes;
-                for (int i = 0; i < pop_count; i++) {
-                    state_stack.pop_back();
-                    reduction_nodes.push_back(symbol_stack.back());
-                    symbol_stack.pop_back();
+            int goto_state = table.go(new_state, reduction.lhs);
+            if (goto_state != -1) {
+                state_stack.push_back(goto_state);
+                // 折叠的转移：途经的单位产生式在栈顶的语义值上原地归约
+                if (!unit_folds.empty()) {
+                    int fold = unit_folds[new_state * non_terminals.size() + reduction.lhs - terminal_count];
+                    if (fold != -1) {
+                        for (int unit : unit_chains[fold]) {
+                            trace.unit(productions[unit]);
+                            symbol_stack.back() = actions.reduce(productions[unit], &symbol_stack.back());
+                        }
+                    }
                 }
-                
-                // 由于栈是后进先出，需要反转子节点顺序
-                reverse(reduction_nodes.begin(), reduction_nodes.end());
-                non_terminal_node = new ParseTreeNode(reduction.left, reduction_nodes[0]->start, reduction_nodes[reduction_nodes.size()-1]->end);
-                non_terminal_node->children = reduction_nodes;
-            }
-            
-            // 压入新的非终结符节点
-            symbol_stack.push_back(non_terminal_node);
-            panick = false;
-            if (!check) cout << " -> 接受！解析成功。" << endl;
-            
-            // 解析成功，返回解析树根节点
-            if (!symbol_stack.empty()) {
-                parse_tree_root = symbol_stack.back();
-                return parse_tree_root;
             } else {
-                if (!check) cout << "错误：符号栈为空，无法获取解析树根节点。" << endl;
-                err(current_input, "Stack is null.");
-                return nullptr;
+                trace.gotoMissing(new_state, reduction);
+                err(*current_input, "Unknown Reduce Item near: " + vocab.name(terminal_idx));
+                continue;
             }
             
         } else {
             // 错误
-            if (!check) cout << " -> 错误：无效操作" << endl;
+            trace.error();
             if (!panick)
-                err(current_input, "near "+ current_input.getId() + ".");
+                err(*current_input, "near "+ vocab.name(terminal_idx) + ".");
             panick = true;
-            if (current_input.getId() == "EOF") return nullptr;
-            input_index++;
+            if (terminal_idx == eof_kind) return fail();
+            current_input = &input.next();
             continue;
         }
         
-        if (!check) cout << endl;
+        trace.endStep();
     }
 }
 
+template <typename Table, typename TokenSource, typename Actions>
+typename Actions::Value LRParser::parseWith(TokenSource& input, Actions& actions, bool trace, Table& table) {
+    // 按是否跟踪选择实例，不跟踪时分析循环中没有逐步的判断和输出
+    if (trace) {
+        ParseTrace tracer{vocab};
+        return drive(input, actions, tracer, table);
+    }
+    NoTrace tracer;
+    return drive(input, actions, tracer, table);
+}
+
+template <typename TokenSource, typename Actions>
+typename Actions::Value LRParser::parse(TokenSource& input, Actions& actions, bool trace) {
+    if (lazy) {
+        LazyTable table{*this};
+        return parseWith(input, actions, trace, table);
+    }
+    FlatTable table{parse_table};
+    return parseWith(input, actions, trace, table);
+}
+
+TreeActions LRParser::resetTree() {
+    // 清理之前的解析树，整个内存池一次释放
+    parse_tree_root = nullptr;
+    tree_arena.reset();
+    return TreeActions{tree_arena};
+}
+
+Program* LRParser::finishAst(AstBuilder& builder, AstBuilder::Value& root) {
+    if (hasErr()) {
+        // 语法错误优先，丢弃已构造的结点和语义错误
+        builder.discard(root);
+        builder.clear();
+        return nullptr;
+    }
+    return builder.accept(root);
+}
+
+template <typename TokenSource>
+ParseTreeNode* LRParser::parseTree(TokenSource& input, bool trace) {
+    TreeActions actions = resetTree();
+    parse_tree_root = parse(input, actions, trace);
+    return parse_tree_root;
+}
+
+template <typename TokenSource>
+Program* LRParser::parseAst(TokenSource& input, AstBuilder& builder, bool trace) {
+    AstBuilder::Value root = parse(input, builder, trace);
+    return finishAst(builder, root);
+}
+
+// 只统计归约步数的跟踪策略
+struct CountTrace : NoTrace {
+    size_t reductions{0};
+
+    void reduce(const Production&, bool) {
+        reductions++;
+    }
+};
+
+size_t LRParser::countReductions(const vector<Token>& tokens) {
+    VectorCursor input{tokens, 0};
+    TreeActions actions = resetTree();
+    CountTrace counter;
+    if (lazy) {
+        LazyTable table{*this};
+        parse_tree_root = drive(input, actions, counter, table);
+    } else {
+        FlatTable table{parse_table};
+        parse_tree_root = drive(input, actions, counter, table);
+    }
+    return counter.reductions;
+}
+
+ParseTreeNode* LRParser::parseTokens(const vector<Token>& tokens, bool trace) {
+    VectorCursor input{tokens, 0};
+    return parseTree(input, trace);
+}
+
+ParseTreeNode* LRParser::parseTokens(TokenCursor& tokens, bool trace) {
+    return parseTree(tokens, trace);
+}
+
+Program* LRParser::parseTokens(const vector<Token>& tokens, AstBuilder& builder, bool trace) {
+    VectorCursor input{tokens, 0};
+    return parseAst(input, builder, trace);
+}
+
+Program* LRParser::parseTokens(TokenCursor& tokens, AstBuilder& builder, bool trace) {
+    return parseAst(tokens, builder, trace);
+}
+
 // 打印解析树
 void LRParser::printParseTree() const {
     if (parse_tree_root) {
-        parse_tree_root->print();
+        parse_tree_root->print(vocab);
     } else {
         //cout << "解析失败!" << endl;
     }
@@ -937,7 +1787,8 @@ void LRParser::exportParseTreeToJSON(const string& filename) const {
         return;
     }
     
-    file << parse_tree_root->toJSON() << endl;
+    parse_tree_root->writeJSON(file, vocab);
+    file << endl;
     file.close();
 }
 
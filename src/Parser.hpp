@@ -1,61 +1,137 @@
 #ifndef PARSER_HPP
 #define PARSER_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
 #include <vector>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 
+#include "AstBuilder.hpp"
+#include "Lexer.hpp"
+#include "util/arena.hpp"
 #include "util/dfa.hpp"
 #include "util/error.hpp"
 #include "util/parserule.hpp"
+#include "util/parsetable.hpp"
 #include "util/parsetree.hpp"
+#include "util/symbolset.hpp"
+#include "util/vocabulary.hpp"
 
 class LRParser {
 private:
+    Vocabulary& vocab;                          // 符号编号表
+    int terminal_count;                         // 终结符个数，终结符编号即ACTION表列号
     std::vector<Production> productions;        // 所有产生式
     std::string start_symbol;                   // 开始符号
     std::set<std::string> non_terminals;             // 非终结符集合
     std::set<std::string> terminals;                 // 终结符集合
     std::vector<ItemSet> canonical_collection;  // 规范LR(0)项集族
+    std::vector<std::vector<int>> productions_by_left;  // 非终结符编号减去终结符个数 -> 以它为左部的产生式编号
+    std::vector<int> production_rank;           // 产生式按（左部, 右部）字典序的排名，决定项集中项的顺序
+    std::vector<int> name_rank;                 // 符号编号 -> 按符号名排列的名次，决定转移的顺序
+    size_t item_stride{1};                      // 项的整数编码：产生式编号 * item_stride + 点的位置
+    std::unordered_map<std::vector<int>, int, KernelHash> kernels;  // 核心项编码 -> 项集编号
+    std::vector<std::vector<int>> buckets;      // 展开项集时按转移符号收集核心项的缓冲
+    std::vector<bool> closed;                   // 项集是否已求闭包并计算了转移
+    bool lazy{false};                           // 项集和分析表的行是否在分析时按需构造
+    unsigned build_threads{1};                  // 构建项集族的线程数
+    static constexpr size_t MIN_STATES_PER_THREAD = 32;  // 一层中每个线程至少分到的项集数，层太小时不启动线程
     
-    std::map<std::string, std::set<std::string>> first_sets;   // FIRST集合
-    std::map<std::string, std::set<std::string>> follow_sets;  // FOLLOW集合
+    std::vector<bool> nullable;                 // 非终结符编号减去终结符个数 -> 能否推导出ε
+    std::vector<SymbolSet> first_sets;          // 非终结符编号减去终结符个数 -> FIRST集合（不含ε），以终结符编号为下标
+    std::vector<SymbolSet> follow_sets;         // 非终结符编号减去终结符个数 -> FOLLOW集合
+    std::vector<int> precedence;                // 终结符编号 -> %left/%right 声明的优先级，0表示未声明
+    std::vector<bool> right_assoc;              // 终结符编号 -> 是否右结合
+    std::vector<int> production_precedence;     // 产生式编号 -> 优先级，取右部最后一个终结符的优先级
     
     std::vector<std::vector<ActionEntry>> action_table;  // ACTION表
-    std::vector<std::map<std::string, int>> goto_table;      // GOTO表
+    std::vector<std::vector<int>> goto_table;      // GOTO表，列号为非终结符编号减去终结符个数，-1表示无转移
+    ParseTable parse_table;                     // 分析驱动使用的扁平ACTION/GOTO表
+    bool comb_tables;                           // 扁平表是否使用行位移压缩
+    bool lalr_tables;                           // 是否构建LALR(1)分析表，否则为SLR(1)
+    bool fold_units;                            // 是否把单位产生式的归约折叠进GOTO转移
+    std::vector<int> unit_folds;                // 状态 * 非终结符个数 + 非终结符编号减去终结符个数 -> unit_chains 的下标，-1表示未折叠
+    std::vector<std::vector<int>> unit_chains;  // 折叠的GOTO转移上依次执行语义动作的单位产生式
 
-    ParseTreeNode* parse_tree_root;
+    ParseTreeNode* parse_tree_root{nullptr};
+    Arena tree_arena;                           // 解析树结点的内存池
     
     bool has_conflicts;                      // 是否存在冲突
+    int conflict_count{0};                   // 冲突的表项数，含按移进解决的S/R冲突，不含按优先级解决的冲突
 
     std::vector<Error> errors;
 
     void err(Token token, std::string errMsg) {
-        Error error("Parse", token.getPos(), errMsg);
+        Error error("Parse", token.getStart(), token.getEnd(), errMsg);
         errors.push_back(error);
     }
 
     // 解析输入文法
     void parseGrammar(const std::vector<std::string>& input);
     
-    // 计算闭包
-    std::set<Item> closure(const std::set<Item>& items);
+    // 由核心项计算闭包，结果按项集的打印顺序排列
+    std::vector<Item> closure(const std::vector<Item>& kernel) const;
     
-    // 计算GOTO函数
-    std::set<Item> computeGoto(const std::set<Item>& items, const std::string& symbol);
-    
-    // 构建规范LR(0)项集族
+    // 产生式分组排名并准备项的编码，项集族中只放入初始项集的核心项
+    void prepareCollection();
+
+    // 按核心项的整数编码查找项集，不存在时新建，返回项集编号
+    int internKernel(const std::vector<int>& kernel);
+
+    // 计算项集的闭包，按转移符号的顺序返回各转移的核心项编码；buckets 为按符号收集核心项的缓冲
+    std::vector<std::pair<int, std::vector<int>>> closeState(int state, std::vector<std::vector<int>>& buckets);
+
+    // 按 closeState 的结果登记项集的转移，新项集追加在项集族末尾
+    void addTransitions(int state, const std::vector<std::pair<int, std::vector<int>>>& transitions);
+
+    // 计算项集的闭包和全部转移
+    void expandState(int state);
+
+    // 构建规范LR(0)项集族，build_threads 大于1时每层BFS并行展开
     void buildCanonicalCollection();
 
-    // 计算FIRST集合
+    // 计算可空性和FIRST集合
     void computeFirstSets();
     
     // 计算FOLLOW集合
     void computeFollowSets();
+
+    // 沿依赖边 dependents[i] 把 sets[i] 并入其后继，直到不再变化
+    static void propagate(std::vector<SymbolSet>& sets, const std::vector<std::vector<int>>& dependents);
     
     // 构建SLR(1)分析表
     void buildSLRTable();
+
+    // 构造分析表中一个状态的ACTION行和GOTO行
+    void buildSLRRow(int state);
+
+    // 构造一个状态的ACTION行和GOTO行，lookahead(产生式编号) 给出归约的向前看符号集合
+    template <typename Lookahead>
+    void buildRow(int state, Lookahead lookahead);
+
+    // 在同一LR(0)项集族上用 DeRemer-Pennello 方法计算向前看符号，构建LALR(1)分析表
+    void buildLALRTable();
+
+    // 沿关系 relation 求 sets 的闭包，同一强连通分量中的集合相同
+    static void digraph(std::vector<SymbolSet>& sets, const std::vector<std::vector<int>>& relation);
+
+    // 把进入后只能按单位产生式 A -> B 归约的状态从GOTO表中折叠掉，填写 unit_folds 和 unit_chains
+    // 返回分析驱动使用的GOTO表，折叠的转移直接到达归约后的状态
+    std::vector<std::vector<int>> foldUnitReductions();
+
+    // 由ACTION表和GOTO表构建分析驱动使用的扁平表，需要时先折叠单位归约
+    void buildParseTable();
+
+    // 懒惰模式下首次进入状态时展开项集并构造其分析表行
+    void materialize(int state);
+
+    // 分析驱动查表的策略：扁平表，或按需构造的懒惰表
+    struct FlatTable;
+    struct LazyTable;
     
     // 辅助函数：修剪字符串两端的空白
     std::string trim(const std::string& str);
@@ -69,10 +145,82 @@ private:
     // 打印项
     std::string itemToString(const Item& item) const;
 
+    // 从缓存文件载入符号表、产生式和分析表，缓存缺失、过期或损坏时返回false
+    bool loadTables(const std::string& cache_file, uint64_t grammar_hash);
+
+    // 将符号表、产生式和分析表写入缓存文件
+    void saveTables(const std::string& cache_file, uint64_t grammar_hash) const;
+
+    // 分析驱动，每次从 input.next() 取一个输入token，移进和归约时由 actions 构造语义值
+    // 分析过程的输出由跟踪策略 trace 决定；分析失败时返回空的语义值
+    template <typename Trace, typename Table, typename TokenSource, typename Actions>
+    typename Actions::Value drive(TokenSource& input, Actions& actions, Trace& trace, Table& table);
+
+    // 按 trace 选择跟踪或不跟踪的分析驱动，查表策略为 table
+    template <typename Table, typename TokenSource, typename Actions>
+    typename Actions::Value parseWith(TokenSource& input, Actions& actions, bool trace, Table& table);
+
+    // 按分析器的构建方式选择查表策略
+    template <typename TokenSource, typename Actions>
+    typename Actions::Value parse(TokenSource& input, Actions& actions, bool trace);
+
+    // 分析并生成解析树
+    template <typename TokenSource>
+    ParseTreeNode* parseTree(TokenSource& input, bool trace);
+
+    // 分析并由语义动作直接构造AST
+    template <typename TokenSource>
+    Program* parseAst(TokenSource& input, AstBuilder& builder, bool trace);
+
+    // 释放之前的解析树，返回在内存池中构造新解析树的语义动作
+    TreeActions resetTree();
+
+    // 有语法错误时丢弃已构造的AST，否则取出程序结点
+    Program* finishAst(AstBuilder& builder, AstBuilder::Value& root);
+
+    // 生成的直接编码分析器报告语法错误的接口，错误信息与表驱动分析相同
+    struct DirectReport {
+        LRParser& parser;
+
+        void unknown(const Token& token) {
+            parser.err(token, "Unknown input token: " + parser.vocab.name(token.getKind()));
+        }
+
+        void error(const Token& token) {
+            parser.err(token, "near " + parser.vocab.name(token.getKind()) + ".");
+        }
+
+        void gotoMissing(const Token& token) {
+            parser.err(token, "Unknown Reduce Item near: " + parser.vocab.name(token.getKind()));
+        }
+    };
+
 public:
-    // 解析输入并构建SLR(1)分析表
+    // 构造函数，文法符号将在符号编号表中最先编号；comb_tables 为真时分析表按行位移压缩，
+    // lalr_tables 为真时构建LALR(1)分析表，fold_units 为真时单位产生式的归约在GOTO转移时完成，
+    // 不再单独进入只做这次归约的状态；语义动作照常执行，解析树和AST的形状不变
+    LRParser(Vocabulary& vocab, bool comb_tables = false, bool lalr_tables = false, bool fold_units = false)
+        : vocab(vocab), terminal_count(0), comb_tables(comb_tables), lalr_tables(lalr_tables), fold_units(fold_units) {}
+
+    // 设置构建项集族的线程数，项集编号和分析表与单线程构建相同
+    void setBuildThreads(unsigned threads) {
+        build_threads = std::max(1u, threads);
+    }
+
+    // 解析输入并构建SLR(1)或LALR(1)分析表
     void buildParser(const std::vector<std::string>& input);
+
+    // 文法文本的哈希，用作分析表缓存的键，也用于检查生成的分析器是否与文法一致
+    static uint64_t grammarHash(const std::vector<std::string>& input);
+
+    // 优先从以文法文本哈希为键的缓存文件载入分析表，缓存不可用时重新构建并写回
+    // 载入时不计算项集族和FIRST/FOLLOW集合，只能用于语法分析
+    void buildParser(const std::vector<std::string>& input, const std::string& cache_file);
     
+    // 懒惰模式：只解析文法并计算FIRST/FOLLOW集合，项集和分析表的行在分析时首次进入状态才构造
+    // 不使用缓存，也不能打印项集族和分析表，适合试验文法或只分析少量程序
+    void buildLazyParser(const std::vector<std::string>& input);
+
     // 打印项集族
     void printCanonicalCollection() const;
     
@@ -91,7 +239,48 @@ public:
     // 打印所有产生式
     void printProductions() const;
 
-    ParseTreeNode* parseTokens(const std::vector<Token>& tokens, bool check = false);
+    // 将SLR(1)自动机输出为直接编码的C++分析器：每个状态是按记号编号 switch 分派的代码块，
+    // 每个产生式是一个专门的归约函数。name 为生成的类名，grammar_hash 为 grammarHash 的结果
+    void writeDirectParser(std::ostream& out, const std::string& name, uint64_t grammar_hash) const;
+
+    // 统计分析token序列时驱动执行的归约步数，折叠进GOTO转移的单位归约不计入
+    size_t countReductions(const std::vector<Token>& tokens);
+
+    // 分析已生成的token序列，trace 为真时逐步输出状态、输入和动作
+    ParseTreeNode* parseTokens(const std::vector<Token>& tokens, bool trace = false);
+
+    // 边词法分析边语法分析，token由游标按需产生
+    ParseTreeNode* parseTokens(TokenCursor& tokens, bool trace = false);
+
+    // 归约时由语义动作直接构造AST，不生成解析树；有语法错误时返回空
+    Program* parseTokens(const std::vector<Token>& tokens, AstBuilder& builder, bool trace = false);
+
+    // 边词法分析边构造AST
+    Program* parseTokens(TokenCursor& tokens, AstBuilder& builder, bool trace = false);
+    
+    // 用生成的直接编码分析器 Direct 代替表驱动分析，语义动作和错误信息与表驱动分析相同
+    // Direct 须由与当前文法一致的 writeDirectParser 生成
+    template <typename Direct>
+    ParseTreeNode* parseTokensDirect(const std::vector<Token>& tokens) {
+        VectorCursor input{tokens, 0};
+        TreeActions actions = resetTree();
+        DirectReport report{*this};
+        parse_tree_root = Direct::parse(input, actions, productions.data(), report);
+        return parse_tree_root;
+    }
+
+    template <typename Direct, typename TokenSource>
+    Program* parseTokensDirect(TokenSource& tokens, AstBuilder& builder) {
+        DirectReport report{*this};
+        AstBuilder::Value root = Direct::parse(tokens, builder, productions.data(), report);
+        return finishAst(builder, root);
+    }
+
+    template <typename Direct>
+    Program* parseTokensDirect(const std::vector<Token>& tokens, AstBuilder& builder) {
+        VectorCursor input{tokens, 0};
+        return parseTokensDirect<Direct>(input, builder);
+    }
     
     // 打印解析树
     void printParseTree() const;
@@ -107,16 +296,39 @@ public:
         errors.clear();
     }
 
+    // 获取符号编号表
+    const Vocabulary& getVocabulary() const {
+        return vocab;
+    }
+
+    // 获取所有产生式，产生式编号即下标
+    const std::vector<Production>& getProductions() const {
+        return productions;
+    }
+
+    // 获取状态数
+    size_t getStateCount() const {
+        return action_table.size();
+    }
+
+    // 获取终结符个数
+    int getTerminalCount() const {
+        return terminal_count;
+    }
+
+    // 获取构建分析表时冲突的表项数
+    int getConflictCount() const {
+        return conflict_count;
+    }
+
+    // 获取分析驱动使用的扁平分析表
+    const ParseTable& getParseTable() const {
+        return parse_table;
+    }
+
     // 获取解析树根节点
     ParseTreeNode* getParseTreeRoot() const {
         return parse_tree_root;
     }
-    
-    // 析构函数中清理解析树
-    ~LRParser() {
-        if (parse_tree_root) {
-            delete parse_tree_root;
-        }
-    }
 };
 #endif
\ No newline at end of file
@@ -14,7 +14,7 @@ private:
     Func* currentFunc{ nullptr };
     std::vector<Error> errors;
     void err(Node* node, std::string errMsg) {
-        Error error("Semantic", node->getPos(), errMsg);
+        Error error("Semantic", node->getStart(), node->getEnd(), errMsg);
         errors.push_back(error);
     }
 public:
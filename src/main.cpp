@@ -1,6 +1,7 @@
 #include <bits/stdc++.h>
 
 #include "util/dfa.hpp"
+#include "util/source.hpp"
 #include "Lexer.hpp"
 #include "Parser.hpp"
 #include "AstBuilder.hpp"
@@ -9,29 +10,54 @@
 #include "IRBuilder.hpp"
 #include "RegAllocator.hpp"
 #include "RVWriter.hpp"
+#include "lex_table.hpp"
+#include "lex_ident_table.hpp"
+#include "keyword_table.hpp"
+#include "parse_direct.hpp"
 using namespace std;
 
-void compile(Lexer& lexer, LRParser& parser, string input, string filename, bool check) {
-    lexer.lex(input);
-                    
-    if (lexer.hasErr()) {
-        lexer.printErrors();
+void compile(Lexer& lexer, LRParser& parser, const SourceBuffer& source, string filename, bool check, bool trace, bool direct, unsigned threads) {
+    // 只做检查时不需要输出解析树，归约时直接构造AST
+    AstBuilder builder(parser.getVocabulary(), parser.getProductions());
+    ParseTreeNode* tree = nullptr;
+    Program* prog = nullptr;
+    if (check && threads <= 1) {
+        // 语法分析器按需从游标取token，不生成token序列
+        TokenCursor tokens(lexer, source);
+        prog = direct ? parser.parseTokensDirect<DirectParser>(tokens, builder) : parser.parseTokens(tokens, builder, trace);
+        // 词法错误优先于由它引起的语法错误
+        if (lexer.hasErr()) {
+            lexer.printErrors();
+            lexer.clear();
+            parser.clear();
+            delete prog;
+            return;
+        }
+    } else {
+        // 需要先输出全部token或并行分析时，先完成词法分析
+        if (threads > 1) {
+            lexer.lexParallel(source, threads);
+        } else {
+            lexer.lex(source);
+        }
+        if (lexer.hasErr()) {
+            lexer.printErrors();
+            if (!check) {
+                lexer.outputErrors(filename + ".err");
+            }
+            lexer.clear();
+            return;
+        }
         if (!check) {
-            lexer.outputErrors(filename + ".err");
+            lexer.printTokens();
+            lexer.outputTokens(filename + ".tokens");
+            tree = direct ? parser.parseTokensDirect<DirectParser>(lexer.getTokens()) : parser.parseTokens(lexer.getTokens(), trace);
+        } else {
+            prog = direct ? parser.parseTokensDirect<DirectParser>(lexer.getTokens(), builder) : parser.parseTokens(lexer.getTokens(), builder, trace);
         }
-        lexer.clear();
-        return;
-    }
-    if (!check) {
-        lexer.printTokens();
-        lexer.outputTokens(filename + ".tokens");
     }
-        
-    vector<Token> tokens(lexer.getTokens());
     lexer.clear();
 
-    ParseTreeNode* tree = parser.parseTokens(tokens, check);
-
     if (parser.hasErr()) {
         parser.printErrors();
         if (!check)
@@ -45,11 +71,12 @@ void compile(Lexer& lexer, LRParser& parser, string input, string filename, bool
         
         // 导出解析树
         parser.exportParseTreeToJSON(filename+ ".cst");
+
+        prog = dynamic_cast<Program*>(builder.visit(tree));
     }
     parser.clear();
 
-    AstBuilder builder;
-    Program* prog = dynamic_cast<Program*>(builder.visit(tree));
+    builder.rethrow();
     if (builder.hasErr()) {
         builder.printErrors();
         if (!check)
@@ -134,18 +161,55 @@ void compile(Lexer& lexer, LRParser& parser, string input, string filename, bool
 
 int main(int argc, char* argv[]) {
     if (argc <= 1) {
-        cout << "help: compiler [file/directory to compiler] [-check]" << endl;
+        cout << "help: compiler [file/directory to compiler, - for stdin] [-check] [-lex=<lex rule file>] [-kwhash] [-threads=<n>] [-comb] [-trace] [-interp] [-lazy] [-lalr] [-fold]" << endl;
         return 0;
     }
     bool check = false;
-    if (argc == 3) {
-        check = true;
+    // 默认使用构建时生成的词法表；-lex 在运行时读取词法规则文件，便于试验新的词法规则
+    string lex_file;
+    // -kwhash：DFA只识别标识符，关键字由完美哈希分类
+    bool kwhash = false;
+    // -threads=<n>：大文件按换行分块并行词法分析，项集族也按BFS层并行构建
+    unsigned threads = 1;
+    // -comb：分析表按行位移压缩，适合大文法
+    bool comb = false;
+    // -trace：逐步输出语法分析的状态、输入和动作
+    bool trace = false;
+    // -interp：使用表驱动分析，不用构建时生成的直接编码分析器
+    bool interp = false;
+    // -lazy：与 -check 一起使用时，项集和分析表的行在分析时按需构造
+    bool lazy = false;
+    // -lalr：在同一LR(0)项集族上构建LALR(1)分析表，代替SLR(1)分析表
+    bool lalr = false;
+    // -fold：表驱动分析时单位产生式的归约在GOTO转移时完成（生成的直接编码分析器总是折叠）
+    bool fold = false;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("-lex=", 0) == 0) {
+            lex_file = arg.substr(5);
+        } else if (arg == "-kwhash") {
+            kwhash = true;
+        } else if (arg == "-comb") {
+            comb = true;
+        } else if (arg == "-trace") {
+            trace = true;
+        } else if (arg == "-interp") {
+            interp = true;
+        } else if (arg == "-lazy") {
+            lazy = true;
+        } else if (arg == "-lalr") {
+            lalr = true;
+        } else if (arg == "-fold") {
+            fold = true;
+        } else if (arg.rfind("-threads=", 0) == 0) {
+            threads = max(1, atoi(arg.c_str() + 9));
+        } else {
+            check = true;
+        }
     }
 
-    string filename = filesystem::canonical(argv[0]).parent_path().string() + "/grammar/lex_rule.lex";
-    DFA dfa(filename);
+    DFA dfa = !lex_file.empty() ? DFA(lex_file) : kwhash ? DFA(LEX_IDENT_TABLE) : DFA(LEX_RULE_TABLE);
     
-    Lexer lexer(dfa);
     if (!dfa.validate()) {
         return 1;
     }
@@ -161,8 +225,24 @@ int main(int argc, char* argv[]) {
         grammar_input.push_back(line);
     }
     
-    LRParser parser;
-    parser.buildParser(grammar_input);
+    // 文法符号最先编号，词法规则中的其余记号（如SKIP）排在其后
+    Vocabulary vocab;
+    LRParser parser(vocab, comb, lalr, fold);
+    parser.setBuildThreads(threads);
+    if (check && lazy && !lalr) {
+        // 不构建完整的项集族，也不读写缓存
+        parser.buildLazyParser(grammar_input);
+    } else if (check) {
+        // 只做检查时从缓存载入分析表，文法改变后自动重新构建
+        parser.buildParser(grammar_input, filesystem::canonical(argv[0]).parent_path().string() + "/gram_rule.cache");
+    } else {
+        // 需要输出项集族和FIRST/FOLLOW集合，完整构建
+        parser.buildParser(grammar_input);
+    }
+    Lexer lexer(dfa, vocab, kwhash ? &KEYWORD_TABLE : nullptr);
+    // 文法与构建时一致才能使用生成的直接编码分析器；跟踪、行位移压缩和懒惰构造只对表驱动分析有意义，
+    // 生成的分析器来自SLR(1)自动机，LALR(1)分析表也只用于表驱动分析
+    bool direct = !interp && !trace && !comb && !lalr && !(check && lazy) && LRParser::grammarHash(grammar_input) == DirectParser::GRAMMAR_HASH;
     if (!check) {
         cout << "\n=== 产生式列表 ===" << endl;
         parser.printProductions();
@@ -185,58 +265,49 @@ int main(int argc, char* argv[]) {
     
     string inputfile = argv[1];
 
-    {
-        ifstream file(inputfile);
-
-        if (!file.is_open()) {
-            //cerr << "无法打开文件: " << filename << endl;
-            exit(1);
-        }
-
-        if (filesystem::is_directory(inputfile)) {
-            for (const auto& entry : filesystem::directory_iterator(inputfile)) {
-                if (entry.is_regular_file() && entry.path().extension() == ".err") {
-                    filesystem::remove(entry.path());
-                }
-                if (entry.is_regular_file() && entry.path().extension() == ".tokens") {
-                    filesystem::remove(entry.path());
-                }
-                if (entry.is_regular_file() && entry.path().extension() == ".cst") {
-                    filesystem::remove(entry.path());
-                }
-                if (entry.is_regular_file() && entry.path().extension() == ".ast") {
-                    filesystem::remove(entry.path());
-                }
-                if (entry.is_regular_file() && entry.path().extension() == ".ir") {
-                    filesystem::remove(entry.path());
-                }
-                if (entry.is_regular_file() && entry.path().extension() == ".alloc") {
-                    filesystem::remove(entry.path());
-                }
-                if (entry.is_regular_file() && entry.path().extension() == ".s") {
-                    filesystem::remove(entry.path());
-                }
+    if (filesystem::is_directory(inputfile)) {
+        for (const auto& entry : filesystem::directory_iterator(inputfile)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".err") {
+                filesystem::remove(entry.path());
+            }
+            if (entry.is_regular_file() && entry.path().extension() == ".tokens") {
+                filesystem::remove(entry.path());
             }
-            for (const auto& entry : filesystem::directory_iterator(inputfile)) {
-                if (entry.is_regular_file() && entry.path().extension() == ".src") {
-                    ifstream prog(entry.path());
-                    if (!prog.is_open()) {
-                        //cerr << "无法打开文件: " << filename << endl;
-                        continue;
-                    }
-                    stringstream buf;
-                    buf << prog.rdbuf();
-                    prog.close();
-
-                    compile(lexer, parser, buf.str(), entry.path().string(), check);
+            if (entry.is_regular_file() && entry.path().extension() == ".cst") {
+                filesystem::remove(entry.path());
+            }
+            if (entry.is_regular_file() && entry.path().extension() == ".ast") {
+                filesystem::remove(entry.path());
+            }
+            if (entry.is_regular_file() && entry.path().extension() == ".ir") {
+                filesystem::remove(entry.path());
+            }
+            if (entry.is_regular_file() && entry.path().extension() == ".alloc") {
+                filesystem::remove(entry.path());
+            }
+            if (entry.is_regular_file() && entry.path().extension() == ".s") {
+                filesystem::remove(entry.path());
+            }
+        }
+        for (const auto& entry : filesystem::directory_iterator(inputfile)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".src") {
+                // 源文件映射到内存，词法分析器直接读取映射
+                auto source = SourceBuffer::load(entry.path().string());
+                if (!source) {
+                    //cerr << "无法打开文件: " << filename << endl;
+                    continue;
                 }
+                compile(lexer, parser, *source, entry.path().string(), check, trace, direct, threads);
             }
-        } else {
-            stringstream buf;
-            buf << file.rdbuf();
-            compile(lexer, parser, buf.str(), "test", check);
         }
-        file.close();
+    } else {
+        // "-" 表示从标准输入读入
+        auto source = SourceBuffer::load(inputfile);
+        if (!source) {
+            //cerr << "无法打开文件: " << filename << endl;
+            exit(1);
+        }
+        compile(lexer, parser, *source, "test", check, trace, direct, threads);
     }
     
     
@@ -0,0 +1,27 @@
+#include <fstream>
+#include <iostream>
+#include "dfa.hpp"
+
+// 构建时的词法分析器生成器：读取 .lex 五元组，编译为稠密转换表并输出C++头文件
+// 用法: lexgen <lex_rule.lex> <输出头文件> [表名]
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "help: lexgen [lex rule file] [output header] [table name]" << std::endl;
+        return 1;
+    }
+    std::string name = argc > 3 ? argv[3] : "LEX_RULE_TABLE";
+
+    DFA dfa(argv[1]);
+    if (!dfa.validate()) {
+        return 1;
+    }
+
+    std::ofstream out(argv[2]);
+    if (!out.is_open()) {
+        std::cerr << "无法打开文件: " << argv[2] << std::endl;
+        return 1;
+    }
+    dfa.writeTable(out, name);
+    out.close();
+    return 0;
+}
@@ -0,0 +1,734 @@
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "keywords.hpp"
+
+// 词法规格生成器：读取以正则表达式描述的记号，依次进行 Thompson 构造、
+// 子集构造和 Hopcroft 最小化，输出 DFA 类可以读取的 .lex 五元组
+// 给出 -keywords 时，正则为单个单词的规则（关键字）不进入DFA，而是生成完美哈希表
+// 用法: lexspec <lex_spec.re> <输出 .lex 文件> [-keywords=<输出头文件>]
+
+/// @brief 字节集合
+using Bytes = std::bitset<256>;
+
+/// @brief 规格中的一条记号定义
+struct Rule {
+    /// @brief 记号名
+    std::string token;
+    /// @brief 优先级，越大越优先
+    int priority;
+    /// @brief 正则表达式
+    std::string regex;
+    /// @brief 所在行号，优先级相同时先出现者优先
+    int line;
+};
+
+/// @brief Thompson NFA
+struct NFA {
+    /// @brief NFA状态：字节边、ε边以及接受的规则编号（-1 表示不接受）
+    struct State {
+        std::vector<std::pair<Bytes, int>> edges;
+        std::vector<int> eps;
+        int rule = -1;
+    };
+    std::vector<State> states;
+
+    int add() {
+        states.emplace_back();
+        return (int)states.size() - 1;
+    }
+};
+
+/// @brief NFA片段，只有一个入口和一个出口
+struct Fragment {
+    int in;
+    int out;
+};
+
+/// @brief 递归下降的正则表达式解析器，边解析边进行 Thompson 构造
+/// 支持 | * + ? ( ) [...] [^...] . 以及 \n \r \t \v \f \s \d \xHH 等转义
+class RegexParser {
+private:
+    const std::string& re;
+    size_t pos = 0;
+    NFA& nfa;
+
+    bool more() const {
+        return pos < re.size();
+    }
+
+    [[noreturn]] void fail(const std::string& msg) const {
+        throw std::runtime_error("正则表达式 \"" + re + "\" 第 " + std::to_string(pos) + " 个字符处" + msg);
+    }
+
+    Fragment bytes(const Bytes& set) {
+        Fragment f{nfa.add(), nfa.add()};
+        nfa.states[f.in].edges.push_back({set, f.out});
+        return f;
+    }
+
+    Fragment empty() {
+        Fragment f{nfa.add(), nfa.add()};
+        nfa.states[f.in].eps.push_back(f.out);
+        return f;
+    }
+
+    /// @brief 解析转义序列，返回其表示的字节集合
+    Bytes escape() {
+        if (!more()) {
+            fail("转义不完整");
+        }
+        char c = re[pos++];
+        Bytes set;
+        switch (c) {
+        case 'n': set.set('\n'); break;
+        case 'r': set.set('\r'); break;
+        case 't': set.set('\t'); break;
+        case 'v': set.set('\v'); break;
+        case 'f': set.set('\f'); break;
+        case '0': set.set(0); break;
+        case 's':
+            for (char s : std::string(" \t\n\v\f\r")) {
+                set.set((unsigned char)s);
+            }
+            break;
+        case 'd':
+            for (int b = '0'; b <= '9'; b++) {
+                set.set(b);
+            }
+            break;
+        case 'x': {
+            if (pos + 2 > re.size()) {
+                fail("\\x 后需要两位十六进制数");
+            }
+            set.set(std::stoi(re.substr(pos, 2), nullptr, 16));
+            pos += 2;
+            break;
+        }
+        default: set.set((unsigned char)c); break;
+        }
+        return set;
+    }
+
+    /// @brief 解析 [...] 字符类，'[' 已被读取
+    Bytes charClass() {
+        bool negate = more() && re[pos] == '^';
+        if (negate) {
+            pos++;
+        }
+        Bytes set;
+        bool first = true;
+        while (more() && (re[pos] != ']' || first)) {
+            first = false;
+            Bytes lo;
+            int loByte = -1;
+            if (re[pos] == '\\') {
+                pos++;
+                lo = escape();
+                if (lo.count() == 1) {
+                    for (int b = 0; b < 256; b++) {
+                        if (lo.test(b)) loByte = b;
+                    }
+                }
+            } else {
+                loByte = (unsigned char)re[pos++];
+                lo.set(loByte);
+            }
+            // 范围 a-b，'-' 位于末尾时按普通字符处理
+            if (loByte >= 0 && pos + 1 < re.size() && re[pos] == '-' && re[pos + 1] != ']') {
+                pos++;
+                int hiByte;
+                if (re[pos] == '\\') {
+                    pos++;
+                    Bytes hi = escape();
+                    if (hi.count() != 1) {
+                        fail("范围的上界必须是单个字符");
+                    }
+                    hiByte = 0;
+                    while (!hi.test(hiByte)) hiByte++;
+                } else {
+                    hiByte = (unsigned char)re[pos++];
+                }
+                if (hiByte < loByte) {
+                    fail("范围上界小于下界");
+                }
+                for (int b = loByte; b <= hiByte; b++) {
+                    lo.set(b);
+                }
+            }
+            set |= lo;
+        }
+        if (!more()) {
+            fail("缺少 ]");
+        }
+        pos++;
+        return negate ? ~set : set;
+    }
+
+    Fragment atom() {
+        char c = re[pos++];
+        switch (c) {
+        case '(': {
+            Fragment f = alternation();
+            if (!more() || re[pos] != ')') {
+                fail("缺少 )");
+            }
+            pos++;
+            return f;
+        }
+        case '[':
+            return bytes(charClass());
+        case '.': {
+            Bytes set;
+            set.set();
+            set.reset('\n');
+            return bytes(set);
+        }
+        case '\\':
+            return bytes(escape());
+        case ')': case '*': case '+': case '?': case '|':
+            pos--;
+            fail("出现意外的字符 " + std::string(1, c));
+        default: {
+            Bytes set;
+            set.set((unsigned char)c);
+            return bytes(set);
+        }
+        }
+    }
+
+    Fragment repetition() {
+        Fragment f = atom();
+        while (more() && (re[pos] == '*' || re[pos] == '+' || re[pos] == '?')) {
+            char op = re[pos++];
+            Fragment r{nfa.add(), nfa.add()};
+            nfa.states[r.in].eps.push_back(f.in);
+            nfa.states[f.out].eps.push_back(r.out);
+            if (op != '+') {
+                nfa.states[r.in].eps.push_back(r.out);
+            }
+            if (op != '?') {
+                nfa.states[f.out].eps.push_back(f.in);
+            }
+            f = r;
+        }
+        return f;
+    }
+
+    Fragment concatenation() {
+        if (!more() || re[pos] == '|' || re[pos] == ')') {
+            return empty();
+        }
+        Fragment f = repetition();
+        while (more() && re[pos] != '|' && re[pos] != ')') {
+            Fragment next = repetition();
+            nfa.states[f.out].eps.push_back(next.in);
+            f.out = next.out;
+        }
+        return f;
+    }
+
+    Fragment alternation() {
+        Fragment f = concatenation();
+        while (more() && re[pos] == '|') {
+            pos++;
+            Fragment rhs = concatenation();
+            Fragment alt{nfa.add(), nfa.add()};
+            nfa.states[alt.in].eps = {f.in, rhs.in};
+            nfa.states[f.out].eps.push_back(alt.out);
+            nfa.states[rhs.out].eps.push_back(alt.out);
+            f = alt;
+        }
+        return f;
+    }
+
+public:
+    RegexParser(const std::string& re, NFA& nfa) : re(re), nfa(nfa) {}
+
+    /// @brief 解析整个正则表达式
+    /// @return 对应的NFA片段
+    Fragment parse() {
+        Fragment f = alternation();
+        if (more()) {
+            fail("出现多余的 )");
+        }
+        return f;
+    }
+};
+
+/// @brief 以稠密表表示的DFA，字节先被映射到等价类
+struct Automaton {
+    /// @brief 下标为 状态 * classCount + 等价类，-1 表示无转换
+    std::vector<int> next;
+    /// @brief 每个状态接受的规则编号，-1 表示非接受状态
+    std::vector<int> accept;
+    int classCount = 0;
+
+    int size() const {
+        return (int)accept.size();
+    }
+};
+
+/// @brief 读取规格文件
+std::vector<Rule> readSpec(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "无法打开文件: " << filename << std::endl;
+        exit(1);
+    }
+    std::vector<Rule> rules;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(file, line)) {
+        lineNo++;
+        std::istringstream in(line);
+        Rule rule;
+        if (!(in >> rule.token) || rule.token[0] == '#') {
+            continue;
+        }
+        // 正则表达式为行内剩余部分，可以包含空格
+        if (in >> rule.priority) {
+            std::getline(in >> std::ws, rule.regex);
+            while (!rule.regex.empty() && std::isspace((unsigned char)rule.regex.back())) {
+                rule.regex.pop_back();
+            }
+        }
+        if (rule.regex.empty()) {
+            std::cerr << filename << ":" << lineNo << ": 规则格式应为 <记号> <优先级> <正则表达式>" << std::endl;
+            exit(1);
+        }
+        rule.line = lineNo;
+        rules.push_back(rule);
+    }
+    return rules;
+}
+
+/// @brief 求状态集合的ε闭包，结果有序
+void closure(const NFA& nfa, std::vector<int>& set) {
+    std::vector<bool> seen(nfa.states.size());
+    std::vector<int> stack = set;
+    set.clear();
+    while (!stack.empty()) {
+        int s = stack.back();
+        stack.pop_back();
+        if (seen[s]) {
+            continue;
+        }
+        seen[s] = true;
+        set.push_back(s);
+        for (int t : nfa.states[s].eps) {
+            stack.push_back(t);
+        }
+    }
+    std::sort(set.begin(), set.end());
+}
+
+/// @brief 子集构造。状态按发现顺序编号，0 为开始状态
+Automaton determinize(const NFA& nfa, int start, const std::vector<Rule>& rules,
+                      const std::vector<int>& representative) {
+    Automaton dfa;
+    dfa.classCount = (int)representative.size();
+    std::map<std::vector<int>, int> ids;
+    std::vector<std::vector<int>> sets;
+
+    std::vector<int> init{start};
+    closure(nfa, init);
+    ids[init] = 0;
+    sets.push_back(init);
+
+    for (size_t d = 0; d < sets.size(); d++) {
+        // 接受优先级最高的规则
+        int best = -1;
+        for (int s : sets[d]) {
+            int r = nfa.states[s].rule;
+            if (r >= 0 && (best < 0 || rules[r].priority > rules[best].priority)) {
+                best = r;
+            }
+        }
+        dfa.accept.push_back(best);
+
+        for (int c = 0; c < dfa.classCount; c++) {
+            std::vector<int> target;
+            for (int s : sets[d]) {
+                for (const auto& [set, t] : nfa.states[s].edges) {
+                    if (set.test(representative[c])) {
+                        target.push_back(t);
+                    }
+                }
+            }
+            if (target.empty()) {
+                dfa.next.push_back(-1);
+                continue;
+            }
+            closure(nfa, target);
+            auto it = ids.find(target);
+            if (it == ids.end()) {
+                it = ids.emplace(target, (int)sets.size()).first;
+                sets.push_back(target);
+            }
+            dfa.next.push_back(it->second);
+        }
+    }
+    return dfa;
+}
+
+/// @brief Hopcroft 最小化。先补全一个死状态，按接受的记号划分初始块，
+/// 再不断用待处理块的逆像细分，最后去掉死状态所在的块
+Automaton minimize(const Automaton& dfa, const std::vector<Rule>& rules) {
+    int n = dfa.size() + 1;
+    int dead = n - 1;
+    int k = dfa.classCount;
+    auto target = [&](int s, int c) {
+        if (s == dead) return dead;
+        int t = dfa.next[s * k + c];
+        return t < 0 ? dead : t;
+    };
+
+    // 逆转换：inverse[c][t] = 经等价类 c 转移到 t 的状态
+    std::vector<std::vector<std::vector<int>>> inverse(k, std::vector<std::vector<int>>(n));
+    for (int s = 0; s < n; s++) {
+        for (int c = 0; c < k; c++) {
+            inverse[c][target(s, c)].push_back(s);
+        }
+    }
+
+    // 初始划分：接受同一记号的状态为一块，非接受状态（含死状态）为一块
+    std::vector<int> block(n);
+    std::vector<std::vector<int>> blocks;
+    std::map<std::string, int> byToken;
+    for (int s = 0; s < n; s++) {
+        std::string key = s == dead || dfa.accept[s] < 0 ? "" : rules[dfa.accept[s]].token;
+        auto it = byToken.find(key);
+        if (it == byToken.end()) {
+            it = byToken.emplace(key, (int)blocks.size()).first;
+            blocks.emplace_back();
+        }
+        block[s] = it->second;
+        blocks[it->second].push_back(s);
+    }
+
+    std::vector<int> worklist;
+    std::vector<bool> pending(blocks.size(), true);
+    for (size_t b = 0; b < blocks.size(); b++) {
+        worklist.push_back((int)b);
+    }
+
+    std::vector<int> hits(n);
+    std::vector<bool> marked(n);
+    while (!worklist.empty()) {
+        int a = worklist.back();
+        worklist.pop_back();
+        pending[a] = false;
+        std::vector<int> splitter = blocks[a];
+        for (int c = 0; c < k; c++) {
+            // 找出经 c 转移进 splitter 的状态，并统计每块命中的个数
+            std::vector<int> pre;
+            for (int t : splitter) {
+                for (int s : inverse[c][t]) {
+                    if (!marked[s]) {
+                        marked[s] = true;
+                        pre.push_back(s);
+                    }
+                }
+            }
+            std::vector<int> touched;
+            for (int s : pre) {
+                if (hits[block[s]]++ == 0) {
+                    touched.push_back(block[s]);
+                }
+            }
+            for (int y : touched) {
+                if (hits[y] < (int)blocks[y].size()) {
+                    // 将块 y 拆为命中部分和其余部分
+                    std::vector<int> in, out;
+                    for (int s : blocks[y]) {
+                        (marked[s] ? in : out).push_back(s);
+                    }
+                    int z = (int)blocks.size();
+                    blocks[y] = out;
+                    blocks.push_back(in);
+                    pending.push_back(false);
+                    for (int s : in) {
+                        block[s] = z;
+                    }
+                    if (pending[y] || in.size() <= out.size()) {
+                        worklist.push_back(z);
+                        pending[z] = true;
+                    } else {
+                        worklist.push_back(y);
+                        pending[y] = true;
+                    }
+                }
+                hits[y] = 0;
+            }
+            for (int s : pre) {
+                marked[s] = false;
+            }
+        }
+    }
+
+    // 按从开始状态出发的广度优先顺序为块重新编号，死状态所在的块不输出
+    Automaton min;
+    min.classCount = k;
+    std::vector<int> id(blocks.size(), -1);
+    std::vector<int> order{block[0]};
+    id[block[0]] = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        int s = blocks[order[i]][0];
+        min.accept.push_back(dfa.accept[s]);
+        for (int c = 0; c < k; c++) {
+            int t = block[target(s, c)];
+            if (t == block[dead]) {
+                min.next.push_back(-1);
+                continue;
+            }
+            if (id[t] < 0) {
+                id[t] = (int)order.size();
+                order.push_back(t);
+            }
+            min.next.push_back(id[t]);
+        }
+    }
+    return min;
+}
+
+/// @brief 将字节集合写成 .lex 文件中的正则表达式：取正反两种写法中较短者，
+/// 非字母数字的字节一律写成 \xHH，保证不含空白
+std::string classRegex(const Bytes& set) {
+    bool negate = set.count() > 128;
+    std::string re = negate ? "[^" : "[";
+    for (int b = 0; b < 256; b++) {
+        if (set.test(b) == negate) {
+            continue;
+        }
+        if (std::isalnum(b)) {
+            re += (char)b;
+        } else {
+            char hex[8];
+            std::snprintf(hex, sizeof(hex), "\\x%02x", b);
+            re += hex;
+        }
+    }
+    return re + "]";
+}
+
+/// @brief 输出 .lex 五元组
+void writeLex(std::ostream& out, const Automaton& dfa, const std::vector<Rule>& rules,
+              const std::vector<int>& byteClass) {
+    auto name = [](int s) {
+        return s == 0 ? std::string("START") : "S" + std::to_string(s);
+    };
+
+    out << dfa.size() << "\n";
+    for (int s = 0; s < dfa.size(); s++) {
+        out << (s ? " " : "") << name(s);
+    }
+    out << "\n\n" << name(0) << "\n\n";
+
+    int acceptCount = 0;
+    for (int s = 0; s < dfa.size(); s++) {
+        acceptCount += dfa.accept[s] >= 0;
+    }
+    out << acceptCount << "\n";
+    for (int s = 0; s < dfa.size(); s++) {
+        if (dfa.accept[s] >= 0) {
+            out << name(s) << " " << rules[dfa.accept[s]].token << "\n";
+        }
+    }
+
+    // 同一对状态之间的所有字节合并为一条转换
+    std::vector<std::string> lines;
+    for (int s = 0; s < dfa.size(); s++) {
+        std::map<int, Bytes> edges;
+        for (int b = 0; b < 256; b++) {
+            int t = dfa.next[s * dfa.classCount + byteClass[b]];
+            if (t >= 0) {
+                edges[t].set(b);
+            }
+        }
+        for (const auto& [t, set] : edges) {
+            lines.push_back(name(s) + " " + classRegex(set) + " " + name(t));
+        }
+    }
+    out << "\n" << lines.size() << "\n";
+    for (const auto& line : lines) {
+        out << line << "\n";
+    }
+}
+
+/// @brief 判断规则的正则表达式是否只是一个单词（关键字）
+bool isKeyword(const Rule& rule) {
+    return std::isalpha((unsigned char)rule.regex[0]) &&
+           std::all_of(rule.regex.begin(), rule.regex.end(), [](char c) { return std::isalnum((unsigned char)c); });
+}
+
+/// @brief 在最小化后的DFA上完整识别一个串
+/// @return 接受的规则编号，不接受时返回 -1
+int run(const Automaton& dfa, const std::vector<int>& byteClass, const std::string& word) {
+    int s = 0;
+    for (char c : word) {
+        s = dfa.next[s * dfa.classCount + byteClass[(unsigned char)c]];
+        if (s < 0) {
+            return -1;
+        }
+    }
+    return dfa.accept[s];
+}
+
+/// @brief 为关键字寻找只用首字节、末字节和长度的完美哈希，并输出为C++头文件
+/// @return 是否成功
+bool writeKeywords(const std::string& filename, const std::vector<Rule>& keywords, const std::string& ident) {
+    for (size_t size = 1; size <= 1024; size *= 2) {
+        if (size < keywords.size()) {
+            continue;
+        }
+        for (unsigned firstMul = 1; firstMul < 256; firstMul++) {
+            for (unsigned lastMul = 0; lastMul < 256; lastMul++) {
+                std::vector<int> slots(size, -1);
+                bool perfect = true;
+                for (size_t k = 0; k < keywords.size() && perfect; k++) {
+                    const std::string& w = keywords[k].regex;
+                    size_t h = keywordHash(w.front(), w.back(), w.size(), firstMul, lastMul, size - 1);
+                    perfect = slots[h] < 0;
+                    slots[h] = (int)k;
+                }
+                if (!perfect) {
+                    continue;
+                }
+
+                std::ofstream out(filename);
+                if (!out.is_open()) {
+                    std::cerr << "无法打开文件: " << filename << std::endl;
+                    return false;
+                }
+                out << "// 由 lexspec 根据词法规格生成，请勿手动修改\n";
+                out << "#ifndef KEYWORD_TABLE_HPP\n";
+                out << "#define KEYWORD_TABLE_HPP\n\n";
+                out << "#include \"keywords.hpp\"\n\n";
+                out << "constexpr const char* KEYWORD_TABLE_WORDS[" << size << "] = {\n";
+                for (int k : slots) {
+                    out << "    \"" << (k < 0 ? "" : keywords[k].regex) << "\",\n";
+                }
+                out << "};\n\n";
+                out << "constexpr const char* KEYWORD_TABLE_TOKENS[" << size << "] = {\n";
+                for (int k : slots) {
+                    out << "    \"" << (k < 0 ? "" : keywords[k].token) << "\",\n";
+                }
+                out << "};\n\n";
+                out << "constexpr KeywordTable KEYWORD_TABLE = {\n";
+                out << "    " << size << ",\n";
+                out << "    " << firstMul << ",\n";
+                out << "    " << lastMul << ",\n";
+                out << "    \"" << ident << "\",\n";
+                out << "    KEYWORD_TABLE_WORDS,\n";
+                out << "    KEYWORD_TABLE_TOKENS,\n";
+                out << "};\n\n";
+                out << "#endif\n";
+                std::cout << filename << ": " << keywords.size() << " 个关键字, 哈希表 " << size << " 个槽" << std::endl;
+                return true;
+            }
+        }
+    }
+    std::cerr << "找不到关键字的完美哈希" << std::endl;
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "help: lexspec [lex spec file] [output lex file] [-keywords=<output header>]" << std::endl;
+        return 1;
+    }
+    std::string keywordFile;
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("-keywords=", 0) == 0) {
+            keywordFile = arg.substr(10);
+        }
+    }
+
+    std::vector<Rule> rules = readSpec(argv[1]);
+    std::vector<Rule> keywords;
+    if (!keywordFile.empty()) {
+        auto it = std::stable_partition(rules.begin(), rules.end(), [](const Rule& r) { return !isKeyword(r); });
+        keywords.assign(it, rules.end());
+        rules.erase(it, rules.end());
+    }
+    if (rules.empty()) {
+        std::cerr << argv[1] << ": 没有任何记号定义" << std::endl;
+        return 1;
+    }
+
+    // Thompson 构造：每条规则一个片段，由公共开始状态经ε边连接
+    NFA nfa;
+    int start = nfa.add();
+    for (size_t r = 0; r < rules.size(); r++) {
+        try {
+            Fragment f = RegexParser(rules[r].regex, nfa).parse();
+            nfa.states[start].eps.push_back(f.in);
+            nfa.states[f.out].rule = (int)r;
+        } catch (const std::exception& e) {
+            std::cerr << argv[1] << ":" << rules[r].line << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // 字节等价类：在所有边上表现相同的字节归为一类
+    std::vector<int> byteClass(256);
+    std::vector<int> representative;
+    std::map<std::vector<bool>, int> signatures;
+    for (int b = 0; b < 256; b++) {
+        std::vector<bool> signature;
+        for (const auto& state : nfa.states) {
+            for (const auto& edge : state.edges) {
+                signature.push_back(edge.first.test(b));
+            }
+        }
+        auto it = signatures.find(signature);
+        if (it == signatures.end()) {
+            it = signatures.emplace(signature, (int)representative.size()).first;
+            representative.push_back(b);
+        }
+        byteClass[b] = it->second;
+    }
+
+    Automaton dfa = determinize(nfa, start, rules, representative);
+    Automaton min = minimize(dfa, rules);
+
+    std::ofstream out(argv[2]);
+    if (!out.is_open()) {
+        std::cerr << "无法打开文件: " << argv[2] << std::endl;
+        return 1;
+    }
+    writeLex(out, min, rules, byteClass);
+    out.close();
+
+    // 关键字必须都被DFA识别为同一个记号（标识符），再由哈希表分类
+    if (!keywordFile.empty()) {
+        std::string ident;
+        for (const Rule& k : keywords) {
+            int r = run(min, byteClass, k.regex);
+            if (r < 0 || (!ident.empty() && rules[r].token != ident)) {
+                std::cerr << argv[1] << ":" << k.line << ": 关键字 " << k.regex << " 必须被同一个标识符记号接受" << std::endl;
+                return 1;
+            }
+            ident = rules[r].token;
+        }
+        if (!keywords.empty() && !writeKeywords(keywordFile, keywords, ident)) {
+            return 1;
+        }
+    }
+
+    std::cout << argv[1] << ": " << rules.size() << " 条规则, "
+              << representative.size() << " 个字节等价类, NFA "
+              << nfa.states.size() << " 个状态, 子集构造后 "
+              << dfa.size() << " 个状态, 最小化后 " << min.size() << " 个状态" << std::endl;
+    return 0;
+}
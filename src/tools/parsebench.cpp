@@ -0,0 +1,141 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "Parser.hpp"
+#include "lex_table.hpp"
+#include "parse_direct.hpp"
+
+// 比较表驱动分析、折叠单位归约的表驱动分析与生成的直接编码分析在同一token序列上的速度和归约步数
+// 用法: parsebench <gram_rule.gra> [源文件] [-n=<重复次数>]，不给源文件时生成一段合成程序
+using namespace std;
+
+// 合成的基准程序：函数定义、循环、条件和表达式交替出现
+static string syntheticProgram(int functions) {
+    string text;
+    for (int i = 0; i < functions; i++) {
+        string f = "f" + to_string(i);
+        text += "int " + f + "(int x; int y[];) { int z; int w[8];\n";
+        text += "    z = x * (x + 2) + y[1]; w[3] = z;\n";
+        text += "    while (z < 100) { z = z + x * 3; if (z <= 50) z = z + 1 else z = z * 2 };\n";
+        text += "    return " + (i > 0 ? "f" + to_string(i - 1) + "(z, w[],)" : string("z")) + "\n};\n";
+    }
+    text += "int a; int b[10];\n";
+    text += "b[2] = 3; a = f" + to_string(functions - 1) + "(b[2], b[],)\n";
+    return text;
+}
+
+// 多次运行 run，返回每次的平均耗时（毫秒）
+template <typename Run>
+static double measure(int repeat, Run run) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) {
+        run();
+    }
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / repeat;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "help: parsebench [grammar file] [source file] [-n=<repeat>]" << endl;
+        return 1;
+    }
+    string source_file;
+    int repeat = 20;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("-n=", 0) == 0) {
+            repeat = max(1, atoi(arg.c_str() + 3));
+        } else {
+            source_file = arg;
+        }
+    }
+
+    ifstream file(argv[1]);
+    if (!file.is_open()) {
+        cerr << "无法打开文件: " << argv[1] << endl;
+        return 1;
+    }
+    vector<string> grammar_input;
+    string line;
+    while (getline(file, line) && !line.empty()) {
+        grammar_input.push_back(line);
+    }
+    if (LRParser::grammarHash(grammar_input) != DirectParser::GRAMMAR_HASH) {
+        cerr << "生成的分析器与文法不一致，请重新构建" << endl;
+        return 1;
+    }
+
+    Vocabulary vocab;
+    LRParser parser(vocab);
+    parser.buildParser(grammar_input);
+    // 单位归约折叠进GOTO转移的表驱动分析器，符号编号与 parser 相同
+    Vocabulary fold_vocab;
+    LRParser folded(fold_vocab, false, false, true);
+    folded.buildParser(grammar_input);
+    Lexer lexer(DFA(LEX_RULE_TABLE), vocab);
+
+    unique_ptr<SourceBuffer> source = source_file.empty() ? make_unique<SourceBuffer>(syntheticProgram(2000)) : SourceBuffer::load(source_file);
+    if (!source) {
+        cerr << "无法打开文件: " << source_file << endl;
+        return 1;
+    }
+    lexer.lex(*source);
+    if (lexer.hasErr()) {
+        lexer.printErrors();
+        return 1;
+    }
+    const vector<Token>& tokens = lexer.getTokens();
+    cout << "token数: " << tokens.size() << "，重复 " << repeat << " 次" << endl;
+
+    // 两种分析的结果须一致
+    AstBuilder builder(parser.getVocabulary(), parser.getProductions());
+    bool table_ok = parser.parseTokens(tokens) != nullptr && !parser.hasErr();
+    parser.clear();
+    bool direct_ok = parser.parseTokensDirect<DirectParser>(tokens) != nullptr && !parser.hasErr();
+    parser.clear();
+    if (table_ok != direct_ok) {
+        cerr << "表驱动分析与直接编码分析的结果不一致" << endl;
+        return 1;
+    }
+
+    size_t reductions = parser.countReductions(tokens);
+    size_t folded_reductions = folded.countReductions(tokens);
+    parser.clear();
+    folded.clear();
+
+    double table_tree = measure(repeat, [&]() {
+        parser.parseTokens(tokens);
+        parser.clear();
+    });
+    double folded_tree = measure(repeat, [&]() {
+        folded.parseTokens(tokens);
+        folded.clear();
+    });
+    double direct_tree = measure(repeat, [&]() {
+        parser.parseTokensDirect<DirectParser>(tokens);
+        parser.clear();
+    });
+    double table_ast = measure(repeat, [&]() {
+        delete parser.parseTokens(tokens, builder);
+        parser.clear();
+        builder.clear();
+    });
+    double folded_ast = measure(repeat, [&]() {
+        delete folded.parseTokens(tokens, builder);
+        folded.clear();
+        builder.clear();
+    });
+    double direct_ast = measure(repeat, [&]() {
+        delete parser.parseTokensDirect<DirectParser>(tokens, builder);
+        parser.clear();
+        builder.clear();
+    });
+
+    cout << fixed;
+    cout.precision(3);
+    cout << "每token归约数  不折叠: " << (double)reductions / tokens.size() << "  折叠单位归约: " << (double)folded_reductions / tokens.size() << endl;
+    cout << "解析树  表驱动: " << table_tree << " ms  折叠: " << folded_tree << " ms  直接编码: " << direct_tree << " ms  加速比: " << table_tree / direct_tree << endl;
+    cout << "AST     表驱动: " << table_ast << " ms  折叠: " << folded_ast << " ms  直接编码: " << direct_ast << " ms  加速比: " << table_ast / direct_ast << endl;
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <fstream>
+#include <iostream>
+#include "Parser.hpp"
+
+// 构建时的语法分析器生成器：读取文法，构建SLR(1)自动机并输出直接编码的C++分析器
+// 用法: parsegen <gram_rule.gra> <输出头文件> [类名] [-fold]，-fold 时单位产生式的归约折叠进GOTO转移
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args;
+    bool fold = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-fold") {
+            fold = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.size() < 2) {
+        std::cerr << "help: parsegen [grammar file] [output header] [class name] [-fold]" << std::endl;
+        return 1;
+    }
+    std::string name = args.size() > 2 ? args[2] : "DirectParser";
+
+    std::ifstream file(args[0]);
+    if (!file.is_open()) {
+        std::cerr << "无法打开文件: " << args[0] << std::endl;
+        return 1;
+    }
+    // 与编译器读取文法的方式相同，遇到空行结束
+    std::vector<std::string> grammar_input;
+    std::string line;
+    while (getline(file, line) && !line.empty()) {
+        grammar_input.push_back(line);
+    }
+
+    Vocabulary vocab;
+    LRParser parser(vocab, false, false, fold);
+    parser.buildParser(grammar_input);
+
+    std::ofstream out(args[1]);
+    if (!out.is_open()) {
+        std::cerr << "无法打开文件: " << args[1] << std::endl;
+        return 1;
+    }
+    parser.writeDirectParser(out, name, LRParser::grammarHash(grammar_input));
+    out.close();
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "Parser.hpp"
+
+// 比较SLR(1)与LALR(1)分析表的生成时间和表的大小
+// 用法: tablebench <文法文件>... [-n=<重复次数>] [-threads=<线程数>]，给出线程数时另测并行构建项集族的时间
+using namespace std;
+
+// 一种分析表的生成结果
+struct TableStats {
+    double build_ms;        // 平均生成时间
+    size_t states;          // 状态数
+    size_t actions;         // 非出错的ACTION表项数
+    int conflicts;          // 冲突的表项数
+    size_t dense;           // 稠密表的整数个数
+    size_t comb;            // 行位移压缩后的整数个数
+};
+
+// 平均生成时间（毫秒）
+static double buildTime(const vector<string>& grammar_input, bool lalr, int repeat, unsigned threads) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) {
+        Vocabulary vocab;
+        LRParser parser(vocab, false, lalr);
+        parser.setBuildThreads(threads);
+        parser.buildParser(grammar_input);
+    }
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / repeat;
+}
+
+static TableStats measure(const vector<string>& grammar_input, bool lalr, int repeat) {
+    TableStats stats{};
+    stats.build_ms = buildTime(grammar_input, lalr, repeat, 1);
+
+    Vocabulary vocab;
+    LRParser parser(vocab, false, lalr);
+    parser.buildParser(grammar_input);
+    stats.states = parser.getStateCount();
+    stats.conflicts = parser.getConflictCount();
+    stats.dense = parser.getParseTable().size();
+    for (size_t state = 0; state < stats.states; state++) {
+        for (int terminal = 0; terminal < parser.getTerminalCount(); terminal++) {
+            if (parser.getParseTable().action(state, terminal).type != ERR) {
+                stats.actions++;
+            }
+        }
+    }
+
+    Vocabulary comb_vocab;
+    LRParser comb_parser(comb_vocab, true, lalr);
+    comb_parser.buildParser(grammar_input);
+    stats.comb = comb_parser.getParseTable().size();
+    return stats;
+}
+
+static void report(const string& kind, const TableStats& stats) {
+    cout << "  " << left << setw(8) << kind << right
+         << setw(10) << stats.build_ms << " ms"
+         << setw(8) << stats.states
+         << setw(10) << stats.actions
+         << setw(8) << stats.conflicts
+         << setw(10) << stats.dense
+         << setw(10) << stats.comb << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "help: tablebench [grammar file]... [-n=<repeat>] [-threads=<n>]" << endl;
+        return 1;
+    }
+    vector<string> grammar_files;
+    int repeat = 20;
+    unsigned threads = 1;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("-n=", 0) == 0) {
+            repeat = max(1, atoi(arg.c_str() + 3));
+        } else if (arg.rfind("-threads=", 0) == 0) {
+            threads = max(1, atoi(arg.c_str() + 9));
+        } else {
+            grammar_files.push_back(arg);
+        }
+    }
+
+    cout << fixed;
+    cout.precision(3);
+    for (const string& grammar_file : grammar_files) {
+        ifstream file(grammar_file);
+        if (!file.is_open()) {
+            cerr << "无法打开文件: " << grammar_file << endl;
+            return 1;
+        }
+        vector<string> grammar_input;
+        string line;
+        while (getline(file, line) && !line.empty()) {
+            grammar_input.push_back(line);
+        }
+
+        cout << grammar_file << "（重复 " << repeat << " 次）" << endl;
+        cout << "  " << left << setw(8) << "表" << right
+             << setw(13) << "生成时间" << setw(8) << "状态" << setw(10) << "ACTION项"
+             << setw(8) << "冲突" << setw(10) << "稠密表" << setw(10) << "压缩表" << endl;
+        report("SLR", measure(grammar_input, false, repeat));
+        report("LALR", measure(grammar_input, true, repeat));
+        if (threads > 1) {
+            cout << "  SLR " << threads << " 线程构建: " << buildTime(grammar_input, false, repeat, threads) << " ms" << endl;
+        }
+    }
+    return 0;
+}
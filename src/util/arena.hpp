@@ -0,0 +1,99 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief 按块分配的指针碰撞（bump）内存池
+/// 对象从当前块的空闲位置依次切出，不能单独释放；reset 一次性释放全部对象，
+/// 分配和释放的开销都只与块数有关。只存放可平凡析构的对象，reset 时不调用析构函数
+class Arena {
+private:
+    /// @brief 默认块大小
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    /// @brief 已分配的块
+    std::vector<std::unique_ptr<char[]>> chunks;
+    /// @brief 当前块的空闲位置
+    char* cur{nullptr};
+    /// @brief 当前块的末尾
+    char* limit{nullptr};
+    /// @brief 第一块的大小，reset 后保留第一块复用
+    size_t first_size{0};
+
+    /// @brief 当前块放不下时分配新块
+    /// @param size 字节数
+    /// @param align 对齐
+    void grow(size_t size, size_t align) {
+        size_t chunk = size + align > CHUNK_SIZE ? size + align : CHUNK_SIZE;
+        chunks.emplace_back(new char[chunk]);
+        if (chunks.size() == 1) first_size = chunk;
+        cur = chunks.back().get();
+        limit = cur + chunk;
+    }
+
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /// @brief 分配一段未初始化的内存
+    /// @param size 字节数
+    /// @param align 对齐
+    /// @return
+    void* allocate(size_t size, size_t align) {
+        size_t pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+        if (cur == nullptr || pad + size > static_cast<size_t>(limit - cur)) {
+            grow(size, align);
+            pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+        }
+        void* p = cur + pad;
+        cur += pad + size;
+        return p;
+    }
+
+    /// @brief 在内存池中构造对象
+    /// @return
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /// @brief 分配未初始化的数组
+    /// @param count 元素个数
+    /// @return
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// @brief 释放全部对象，保留第一块供下次使用
+    void reset() {
+        if (chunks.empty()) return;
+        chunks.resize(1);
+        cur = chunks[0].get();
+        limit = cur + first_size;
+    }
+};
+
+/// @brief 内存池中的定长数组视图，不拥有元素
+template <typename T>
+struct ArenaArray {
+    T* items{nullptr};
+    size_t count{0};
+
+    T* begin() const { return items; }
+    T* end() const { return items + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t i) const { return items[i]; }
+};
+
+#endif
@@ -33,33 +33,30 @@ class Program;
 /// @brief AST结点类基类
 class Node {
 private:
-    /// @brief 结点在源程序的位置
-    size_t pos[4];
+    /// @brief 结点在源程序的开始位置
+    SourcePos start;
+    /// @brief 结点在源程序的结束位置
+    SourcePos end;
 public:
     /// @brief 根据token构建结点类
     /// @param token 
-    Node(Token start, Token end) {
-        pos[0] = start.getPos()[0];
-        pos[1] = start.getPos()[1];
-        pos[2] = end.getPos()[2];
-        pos[3] = end.getPos()[3];
-    }
+    Node(Token start, Token end) : start(start.getStart()), end(end.getEnd()) {}
 
     /// @brief 直接根据位置构建节点类
-    /// @param p 位置
-    Node(size_t p[]) {
-        pos[0] = p[0];
-        pos[1] = p[1];
-        pos[2] = p[2];
-        pos[3] = p[3];
-    }
+    /// @param start 开始位置
+    /// @param end 结束位置
+    Node(SourcePos start, SourcePos end) : start(start), end(end) {}
 
     /// @brief 析构函数
     virtual ~Node() = default;
 
-    /// @brief 获取结点位置
-    /// @return int[2]表示结点的开始、结束位置（字节数）
-    size_t* getPos() { return pos; }
+    /// @brief 获取结点开始位置
+    /// @return 
+    SourcePos getStart() const { return start; }
+
+    /// @brief 获取结点结束位置
+    /// @return 
+    SourcePos getEnd() const { return end; }
 };
 
 /// @brief AST结点声明类
@@ -84,8 +81,9 @@ public:
     Expr(Token start, Token end) : Node(start, end) {}
 
     /// @brief 根据位置构建表达式类
-    /// @param pos 
-    Expr(size_t pos[]) : Node(pos) {}
+    /// @param start 开始位置
+    /// @param end 结束位置
+    Expr(SourcePos start, SourcePos end) : Node(start, end) {}
 
     /// @brief 析构函数
     virtual ~Expr() = default;
@@ -110,7 +108,7 @@ public:
     /// @param expr 源表达式
     /// @param from 源类型
     /// @param to 目标类型
-    Cast(Expr* expr, IType* from, IType* to) : Expr(expr->getPos()), from(from), to(to), expr(expr) {
+    Cast(Expr* expr, IType* from, IType* to) : Expr(expr->getStart(), expr->getEnd()), from(from), to(to), expr(expr) {
         setType(to);
     }
 
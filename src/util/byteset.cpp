@@ -0,0 +1,84 @@
+#include "byteset.hpp"
+
+#if defined(__SSE2__) && !defined(LIGHTCC_NO_SIMD)
+#define BYTESET_SIMD 1
+#include <immintrin.h>
+#endif
+
+ByteSet::ByteSet() : member(), bytes(), count(0) {}
+
+void ByteSet::insert(unsigned char c) {
+    if (member[c]) return;
+    member[c] = true;
+    if (count < MAX_VECTOR_BYTES) {
+        bytes[count] = c;
+    }
+    count++;
+}
+
+#ifdef BYTESET_SIMD
+
+// 每次比较16字节，返回集合成员的位掩码
+static inline unsigned matchSSE2(const char* p, const unsigned char* bytes, int count) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hit = _mm_setzero_si128();
+    for (int k = 0; k < count; k++) {
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(bytes[k]))));
+    }
+    return static_cast<unsigned>(_mm_movemask_epi8(hit));
+}
+
+static size_t findSSE2(const char* data, size_t pos, size_t end, const unsigned char* bytes, int count, bool want) {
+    unsigned flip = want ? 0 : 0xFFFFu;
+    for (; pos + 16 <= end; pos += 16) {
+        unsigned mask = matchSSE2(data + pos, bytes, count) ^ flip;
+        if (mask) return pos + __builtin_ctz(mask);
+    }
+    return pos;
+}
+
+// 每次比较32字节，只在运行时检测到AVX2时调用
+__attribute__((target("avx2")))
+static size_t findAVX2(const char* data, size_t pos, size_t end, const unsigned char* bytes, int count, bool want) {
+    unsigned flip = want ? 0 : 0xFFFFFFFFu;
+    for (; pos + 32 <= end; pos += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        __m256i hit = _mm256_setzero_si256();
+        for (int k = 0; k < count; k++) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(bytes[k]))));
+        }
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hit)) ^ flip;
+        if (mask) return pos + __builtin_ctz(mask);
+    }
+    return pos;
+}
+
+static bool hasAVX2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#endif
+
+size_t ByteSet::find(std::string_view input, size_t pos, bool want) const {
+    const char* data = input.data();
+    size_t end = input.size();
+#ifdef BYTESET_SIMD
+    // 短的跨度直接查表，避免向量化的启动开销
+    if (count <= MAX_VECTOR_BYTES && pos + 16 <= end && member[static_cast<unsigned char>(data[pos])] != want) {
+        size_t found = hasAVX2() ? findAVX2(data, pos, end, bytes, count, want) : pos;
+        if (found == end || member[static_cast<unsigned char>(data[found])] == want) {
+            return found;
+        }
+        found = findSSE2(data, found, end, bytes, count, want);
+        if (found == end || member[static_cast<unsigned char>(data[found])] == want) {
+            return found;
+        }
+        pos = found;
+    }
+#endif
+    while (pos < end && member[static_cast<unsigned char>(data[pos])] != want) {
+        pos++;
+    }
+    return pos;
+}
@@ -0,0 +1,69 @@
+#ifndef BYTESET_HPP
+#define BYTESET_HPP
+
+#include <cstddef>
+#include <string_view>
+
+/// @brief 字节集合，用于在输入中快速跳过或查找一类字节
+/// 集合不超过 MAX_VECTOR_BYTES 个字节时使用SIMD（AVX2/SSE2）逐块比较，否则逐字节查表
+class ByteSet {
+public:
+    /// @brief SIMD比较支持的最大字节个数
+    static const int MAX_VECTOR_BYTES = 8;
+
+private:
+    /// @brief 查表用的成员标记
+    bool member[256];
+    /// @brief 集合中的字节（仅在 count <= MAX_VECTOR_BYTES 时有效）
+    unsigned char bytes[MAX_VECTOR_BYTES];
+    /// @brief 集合中的字节个数
+    int count;
+
+    /// @brief 查找第一个属于（want为true）或不属于（want为false）集合的字节
+    size_t find(std::string_view input, size_t pos, bool want) const;
+
+public:
+    /// @brief 构造空集合
+    ByteSet();
+
+    /// @brief 向集合中加入字节
+    /// @param c 
+    void insert(unsigned char c);
+
+    /// @brief 判断字节是否在集合中
+    /// @param c 
+    /// @return 
+    bool contains(unsigned char c) const {
+        return member[c];
+    }
+
+    /// @brief 集合是否为空
+    /// @return 
+    bool empty() const {
+        return count == 0;
+    }
+
+    /// @brief 集合中的字节个数
+    /// @return 
+    int size() const {
+        return count;
+    }
+
+    /// @brief 从pos开始跳过集合中的字节
+    /// @param input 输入
+    /// @param pos 开始偏移
+    /// @return 第一个不在集合中的字节的偏移，没有则为input.size()
+    size_t skip(std::string_view input, size_t pos) const {
+        return find(input, pos, false);
+    }
+
+    /// @brief 从pos开始查找集合中的字节
+    /// @param input 输入
+    /// @param pos 开始偏移
+    /// @return 第一个在集合中的字节的偏移，没有则为input.size()
+    size_t seek(std::string_view input, size_t pos) const {
+        return find(input, pos, true);
+    }
+};
+
+#endif
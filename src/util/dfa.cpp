@@ -44,6 +44,100 @@ DFA::DFA(const std::string& filename) {
     }
     
     file.close();
+
+    compile();
+    accelerate();
+}
+
+DFA::DFA(const LexTable& lexTable) {
+    start = lexTable.start;
+    stateNames.assign(lexTable.states, lexTable.states + lexTable.stateCount);
+    tokens.assign(lexTable.tokens, lexTable.tokens + lexTable.tokenCount);
+    table.assign(lexTable.transitions, lexTable.transitions + lexTable.stateCount * 256);
+    accept.assign(lexTable.accept, lexTable.accept + lexTable.stateCount);
+
+    // 还原五元组中 validate 用到的部分
+    states.insert(stateNames.begin(), stateNames.end());
+    startState = stateNames[start];
+    for (int s = 0; s < lexTable.stateCount; s++) {
+        if (accept[s] >= 0) {
+            acceptStates[stateNames[s]] = tokens[accept[s]];
+        }
+    }
+
+    accelerate();
+}
+
+// 预先编译所有转换：对每个状态的每个字节只匹配一次正则，扫描时只需查表
+void DFA::compile() {
+    std::map<std::string, int> ids;
+    auto stateId = [&](const std::string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        int id = stateNames.size();
+        ids[name] = id;
+        stateNames.push_back(name);
+        return id;
+    };
+    for (const auto& state : states) {
+        stateId(state);
+    }
+    start = stateId(startState);
+    for (const auto& p : transitions) {
+        stateId(p.first.first);
+        stateId(p.second);
+    }
+    for (const auto& p : acceptStates) {
+        stateId(p.first);
+    }
+
+    // 接受状态 -> token编号
+    accept.assign(stateNames.size(), -1);
+    std::map<std::string, int> tokenIds;
+    for (const auto& p : acceptStates) {
+        auto it = tokenIds.find(p.second);
+        if (it == tokenIds.end()) {
+            it = tokenIds.emplace(p.second, tokens.size()).first;
+            tokens.push_back(p.second);
+        }
+        accept[ids[p.first]] = it->second;
+    }
+
+    // 与逐字符匹配时一致：按转换表的遍历顺序，第一个匹配的正则生效
+    table.assign(stateNames.size() * 256, -1);
+    for (const auto& p : transitions) {
+        int from = ids[p.first.first];
+        int to = ids[p.second];
+        std::regex rgx(p.first.second);
+        for (int c = 0; c < 256; c++) {
+            int& entry = table[from * 256 + c];
+            if (entry != -1) continue;
+            std::string s(1, static_cast<char>(c));
+            if (std::regex_match(s, rgx)) {
+                entry = to;
+            }
+        }
+    }
+}
+
+// 找出有自环且出口字节很少的状态，扫描时用SIMD直接跳到出口字节
+void DFA::accelerate() {
+    accel.assign(stateNames.size(), -1);
+    for (size_t s = 0; s < stateNames.size(); s++) {
+        ByteSet out;
+        bool selfLoop = false;
+        for (int c = 0; c < 256; c++) {
+            if (table[s * 256 + c] == static_cast<int>(s)) {
+                selfLoop = true;
+            } else {
+                out.insert(c);
+            }
+        }
+        if (selfLoop && !out.empty() && out.size() <= ByteSet::MAX_VECTOR_BYTES) {
+            accel[s] = exits.size();
+            exits.push_back(out);
+        }
+    }
 }
 
 bool DFA::validate() {
@@ -73,30 +167,121 @@ bool DFA::validate() {
 
 // 使用DFA验证字符串
 std::pair<std::string, size_t> DFA::recognizeString(const std::string& input) {
-    std::string currentState = startState;
-    size_t i = 0;
-    for (i = 0; i < input.length(); i++) {
-        char c = input[i];
-        std::string s(1, c);
-        bool found = false;
+    return recognize(input, 0);
+}
+
+std::pair<std::string, size_t> DFA::recognize(std::string_view input, size_t start) const {
+    auto p = match(input, start);
+    return make_pair(p.first < 0 ? std::string() : tokens[p.first], p.second);
+}
+
+std::pair<int, size_t> DFA::match(std::string_view input, size_t start) const {
+    auto p = run(input, start, this->start);
+    
+    // 检查最终状态是否为接受状态
+    return std::make_pair(accept[p.first], p.second - start);
+}
+
+std::pair<int, size_t> DFA::run(std::string_view input, size_t start, int state) const {
+    int currentState = state;
+    size_t i = start;
+    if (accel[currentState] >= 0) {
+        // 从自环状态中间继续（如跨越分块的注释）
+        i = exits[accel[currentState]].seek(input, i);
+    }
+    for (; i < input.length(); i++) {
         // 获取下一个状态
-        for (const auto& p : transitions) {
-            std::smatch result;
-            std::regex rgx(p.first.second);
-	        bool ret = regex_match(s, result, rgx);
-            if (p.first.first == currentState && ret) {
-                currentState = p.second;
-                found = true;
-                break;
-            }
+        int next = table[currentState * 256 + static_cast<unsigned char>(input[i])];
+        if (next < 0) break;
+        if (next != currentState && accel[next] >= 0) {
+            // 进入自环状态（如注释体）：直接跳到第一个会离开该状态的字节
+            currentState = next;
+            i = exits[accel[next]].seek(input, i + 1) - 1;
+            continue;
         }
-        if (!found) break;
+        currentState = next;
     }
-    
-    // 检查最终状态是否为接受状态
-    bool isAccepted = acceptStates.find(currentState) != acceptStates.end();
-    std::string token = isAccepted ? acceptStates.find(currentState)->second : "";
-    return make_pair(token, i);
+    return std::make_pair(currentState, i);
+}
+
+bool DFA::hasTransitions(int state) const {
+    for (int c = 0; c < 256; c++) {
+        if (table[state * 256 + c] >= 0) return true;
+    }
+    return false;
+}
+
+std::vector<int> DFA::targets(unsigned char c) const {
+    std::set<int> result;
+    for (size_t s = 0; s < stateNames.size(); s++) {
+        if (table[s * 256 + c] >= 0) {
+            result.insert(table[s * 256 + c]);
+        }
+    }
+    return std::vector<int>(result.begin(), result.end());
+}
+
+void DFA::writeTable(std::ostream& out, const std::string& name) const {
+    int stateCount = stateNames.size();
+    out << "// 由 lexgen 根据词法规则生成，请勿手动修改\n";
+    out << "#ifndef " << name << "_HPP\n";
+    out << "#define " << name << "_HPP\n\n";
+    out << "#include \"dfa.hpp\"\n\n";
+
+    out << "constexpr int " << name << "_TRANSITIONS[" << stateCount * 256 << "] = {\n";
+    for (int s = 0; s < stateCount; s++) {
+        out << "    // " << stateNames[s] << "\n";
+        for (int c = 0; c < 256; c++) {
+            out << (c % 16 == 0 ? "    " : " ") << table[s * 256 + c] << ",";
+            if (c % 16 == 15) out << "\n";
+        }
+    }
+    out << "};\n\n";
+
+    out << "constexpr int " << name << "_ACCEPT[" << stateCount << "] = {";
+    for (int s = 0; s < stateCount; s++) {
+        out << (s % 16 == 0 ? "\n    " : " ") << accept[s] << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "constexpr const char* " << name << "_TOKENS[" << tokens.size() << "] = {\n";
+    for (const auto& token : tokens) {
+        out << "    \"" << token << "\",\n";
+    }
+    out << "};\n\n";
+
+    out << "constexpr const char* " << name << "_STATES[" << stateCount << "] = {\n";
+    for (const auto& state : stateNames) {
+        out << "    \"" << state << "\",\n";
+    }
+    out << "};\n\n";
+
+    out << "constexpr LexTable " << name << " = {\n";
+    out << "    " << stateCount << ",\n";
+    out << "    " << start << ",\n";
+    out << "    " << name << "_TRANSITIONS,\n";
+    out << "    " << name << "_ACCEPT,\n";
+    out << "    " << tokens.size() << ",\n";
+    out << "    " << name << "_TOKENS,\n";
+    out << "    " << name << "_STATES,\n";
+    out << "};\n\n";
+    out << "#endif\n";
+}
+
+ByteSet DFA::singleByteTokens(int token) const {
+    ByteSet result;
+    for (int c = 0; c < 256; c++) {
+        int next = table[start * 256 + c];
+        if (next < 0 || accept[next] != token) continue;
+        bool terminal = true;
+        for (int d = 0; d < 256 && terminal; d++) {
+            terminal = table[next * 256 + d] < 0;
+        }
+        if (terminal) {
+            result.insert(c);
+        }
+    }
+    return result;
 }
 
 void recognizeFile(const std::string& filename, DFA dfa) {
@@ -114,7 +299,7 @@ void recognizeFile(const std::string& filename, DFA dfa) {
     }
 
     for (size_t i = 0; i < input.size();) {
-        auto p = dfa.recognizeString(input.substr(i));
+        auto p = dfa.recognize(input, i);
         std::string token = p.first;
         size_t ori = i;
         i += p.second;
@@ -142,7 +327,7 @@ void recognizeCin(DFA dfa) {
         input += ch;
     }
     for (size_t i = 0; i < input.size();) {
-        auto p = dfa.recognizeString(input.substr(i));
+        auto p = dfa.recognize(input, i);
         std::string token = p.first;
         size_t ori = i;
         i += p.second;
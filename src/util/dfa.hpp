@@ -2,8 +2,30 @@
 #define DFA_HPP
 
 #include <map>
+#include <ostream>
 #include <set>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "byteset.hpp"
+
+/// @brief 构建时由 lexgen 从 .lex 文件生成的DFA表（见 build/gen/lex_table.hpp）
+struct LexTable {
+    /// @brief 状态个数
+    int stateCount;
+    /// @brief 开始状态编号
+    int start;
+    /// @brief 稠密转换表，stateCount * 256 项，-1 表示无转换
+    const int* transitions;
+    /// @brief 每个状态接受的token编号，-1 表示非接受状态
+    const int* accept;
+    /// @brief token个数
+    int tokenCount;
+    /// @brief token编号 -> token名
+    const char* const* tokens;
+    /// @brief 状态编号 -> 状态名
+    const char* const* states;
+};
 
 /// @brief DFA
 class DFA {
@@ -16,11 +38,36 @@ private:
     std::map<std::string, std::string> acceptStates;    
     /// @brief 状态转换表
     std::map<std::pair<std::string, std::string>, std::string> transitions;
+
+    /// @brief 状态编号 -> 状态名
+    std::vector<std::string> stateNames;
+    /// @brief 开始状态编号
+    int start;
+    /// @brief 稠密转换表，下标为 状态编号 * 256 + 字节，-1 表示无转换
+    std::vector<int> table;
+    /// @brief 每个状态接受的token编号，-1 表示非接受状态
+    std::vector<int> accept;
+    /// @brief token编号 -> token名
+    std::vector<std::string> tokens;
+    /// @brief 可加速状态在 exits 中的下标，-1 表示不可加速
+    std::vector<int> accel;
+    /// @brief 可加速状态（如注释体）的出口字节集合：除这些字节外都转移回自身
+    std::vector<ByteSet> exits;
+
+    /// @brief 将正则表示的转换编译为稠密转换表
+    void compile();
+
+    /// @brief 找出可以用SIMD加速的自环状态
+    void accelerate();
 public:
     /// @brief 读入文件构造DFA
     /// @param filename 文件名
     DFA(const std::string& filename);
 
+    /// @brief 由构建时生成的表构造DFA，不读取文件
+    /// @param lexTable 生成的DFA表
+    DFA(const LexTable& lexTable);
+
     /// @brief 检查DFA是否合法
     /// @return 
     bool validate();
@@ -29,6 +76,70 @@ public:
     /// @param input 字符串
     /// @return 一个pair，表示接受的Token及其接受字符串的长度
     std::pair<std::string, size_t> recognizeString(const std::string& input);
+
+    /// @brief 从指定偏移开始识别一个token，不复制输入
+    /// @param input 整个输入
+    /// @param start 开始偏移
+    /// @return 一个pair，表示接受的Token及其接受字符串的长度
+    std::pair<std::string, size_t> recognize(std::string_view input, size_t start) const;
+
+    /// @brief 从指定偏移开始识别一个token
+    /// @param input 整个输入
+    /// @param start 开始偏移
+    /// @return 一个pair，表示接受的token编号（-1表示不接受）及其接受字符串的长度
+    std::pair<int, size_t> match(std::string_view input, size_t start) const;
+
+    /// @brief 从指定状态和偏移继续运行DFA，直到没有转换或到达输入末尾
+    /// @param input 输入，运行不会越过其末尾
+    /// @param start 开始偏移
+    /// @param state 开始状态编号
+    /// @return 一个pair，表示停止时的状态编号及停止的偏移
+    std::pair<int, size_t> run(std::string_view input, size_t start, int state) const;
+
+    /// @brief 获取开始状态编号
+    /// @return 
+    int getStart() const {
+        return start;
+    }
+
+    /// @brief 获取状态经某字节转换到的状态
+    /// @return 状态编号，-1 表示无转换
+    int step(int state, unsigned char c) const {
+        return table[state * 256 + c];
+    }
+
+    /// @brief 获取状态接受的token编号
+    /// @return token编号，-1 表示非接受状态
+    int acceptToken(int state) const {
+        return accept[state];
+    }
+
+    /// @brief 状态是否有任何转换
+    /// @param state 状态编号
+    /// @return 
+    bool hasTransitions(int state) const;
+
+    /// @brief 所有状态经某字节能转换到的状态
+    /// @param c 字节
+    /// @return 去重后的状态编号
+    std::vector<int> targets(unsigned char c) const;
+
+    /// @brief 从开始状态出发、单个字节即构成完整token的字节集合
+    /// 这些字节之后必然开始新的token，词法分析器可以成段跳过
+    /// @param token token编号
+    /// @return 
+    ByteSet singleByteTokens(int token) const;
+
+    /// @brief 将编译好的表输出为C++头文件，供 DFA(const LexTable&) 使用
+    /// @param out 输出流
+    /// @param name 生成的 LexTable 常量名
+    void writeTable(std::ostream& out, const std::string& name) const;
+
+    /// @brief 获取所有token名，下标即token编号
+    /// @return 
+    const std::vector<std::string>& getTokens() const {
+        return tokens;
+    }
 };
 
 /// @brief 识别文件输入
@@ -40,4 +151,4 @@ void recognizeFile(const std::string& filename, DFA dfa);
 /// @param dfa 
 void recognizeCin(DFA dfa);
 
-#endif
\ No newline at end of file
+#endif
@@ -3,34 +3,33 @@
 
 #include <string>
 #include <sstream>
+#include "source.hpp"
 
 /// @brief 错误类
 class Error {
     private:
         /// @brief 错误类型：词法错误、语法错误、语义错误
         std::string type;
-        /// @brief 错误位置
-        size_t position[4];
+        /// @brief 错误开始位置
+        SourcePos start;
+        /// @brief 错误结束位置
+        SourcePos end;
         /// @brief 错误信息
         std::string errMsg;
     public:
         /// @brief 构造函数
         /// @param type 错误类型
-        /// @param position 错误位置
+        /// @param start 错误开始位置
+        /// @param end 错误结束位置
         /// @param errMsg 错误信息
-        Error(std::string type, size_t position[], std::string errMsg) : type(type), errMsg(errMsg) {
-            this->position[0] = position[0];
-            this->position[1] = position[1];
-            this->position[2] = position[2];
-            this->position[3] = position[3];
-        }
+        Error(std::string type, SourcePos start, SourcePos end, std::string errMsg) : type(type), start(start), end(end), errMsg(errMsg) {}
 
         /// @brief 将错误转换为string
         /// @return string
         std::string toString() {
             std::ostringstream oss;
-            oss << "error:" << position[0] << ":" << position[1] << ":" << position[2] << ":" << position[3] << ":" << type << " error " << errMsg << ".";
+            oss << "error:" << start.line() << ":" << start.col() << ":" << end.line() << ":" << end.col() << ":" << type << " error " << errMsg << ".";
             return oss.str();
         }
 };
-#endif
\ No newline at end of file
+#endif
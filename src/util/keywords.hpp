@@ -0,0 +1,88 @@
+#ifndef KEYWORDS_HPP
+#define KEYWORDS_HPP
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "vocabulary.hpp"
+
+/// @brief 关键字完美哈希：只取首字节、末字节和长度
+/// @param first 首字节
+/// @param last 末字节
+/// @param length 长度
+/// @param firstMul 首字节的乘数
+/// @param lastMul 末字节的乘数
+/// @param mask 槽数减一，槽数为2的幂
+/// @return 槽号
+constexpr size_t keywordHash(unsigned char first, unsigned char last, size_t length,
+                             unsigned firstMul, unsigned lastMul, size_t mask) {
+    return (first * firstMul + last * lastMul + length) & mask;
+}
+
+/// @brief 构建时由 lexspec 从词法规格生成的关键字哈希表（见 build/gen/keyword_table.hpp）
+struct KeywordTable {
+    /// @brief 槽数，为2的幂
+    int size;
+    /// @brief 首字节的乘数
+    unsigned firstMul;
+    /// @brief 末字节的乘数
+    unsigned lastMul;
+    /// @brief 关键字在DFA中被识别成的记号，如 ID
+    const char* ident;
+    /// @brief 槽号 -> 关键字，空槽为空串
+    const char* const* words;
+    /// @brief 槽号 -> 关键字的记号名
+    const char* const* tokens;
+};
+
+/// @brief 关键字分类器：DFA只识别一般的标识符，再由完美哈希判断是否为关键字
+/// 每次查询只计算一次哈希，比较一次长度和一次内存
+class KeywordHash {
+private:
+    /// @brief 哈希槽
+    struct Slot {
+        std::string_view word;
+        int kind{-1};
+    };
+    std::vector<Slot> slots;
+    unsigned firstMul{0};
+    unsigned lastMul{0};
+    size_t mask{0};
+    /// @brief 需要再分类的记号编号，-1 表示不启用
+    int ident{-1};
+
+public:
+    /// @brief 构造一个不识别任何关键字的分类器
+    KeywordHash() = default;
+
+    /// @brief 由生成的表构造，记号名在此时统一换成编号
+    /// @param table 生成的关键字哈希表
+    /// @param vocab 符号编号表
+    KeywordHash(const KeywordTable& table, Vocabulary& vocab)
+        : slots(table.size), firstMul(table.firstMul), lastMul(table.lastMul),
+          mask(table.size - 1), ident(vocab.intern(table.ident)) {
+        for (int i = 0; i < table.size; i++) {
+            if (table.words[i][0] != '\0') {
+                slots[i] = Slot{table.words[i], vocab.intern(table.tokens[i])};
+            }
+        }
+    }
+
+    /// @brief 获取需要再分类的记号编号
+    /// @return 不启用时为 -1
+    int identKind() const {
+        return ident;
+    }
+
+    /// @brief 判断标识符是否为关键字
+    /// @param word 标识符，非空
+    /// @return 关键字的记号编号，不是关键字时返回 -1
+    int classify(std::string_view word) const {
+        const Slot& slot = slots[keywordHash(word.front(), word.back(), word.size(), firstMul, lastMul, mask)];
+        return slot.word.size() == word.size() && std::memcmp(slot.word.data(), word.data(), word.size()) == 0
+            ? slot.kind : -1;
+    }
+};
+
+#endif
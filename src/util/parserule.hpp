@@ -1,6 +1,7 @@
 #ifndef PARSERULE_HPP
 #define PARSERULE_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <set>
@@ -11,6 +12,8 @@ struct Production {
     std::string left;            // 产生式左部
     std::vector<std::string> right;   // 产生式右部
     int id;                 // 产生式编号
+    int lhs;                // 左部符号编号
+    std::vector<int> rhs;   // 右部符号编号
     
     bool operator==(const Production& other) const;
     bool operator<(const Production& other) const;
@@ -18,30 +21,41 @@ struct Production {
     void print();
 };
 
-// 表示一个项目
+// 表示一个项目，以产生式编号和点的位置两个整数表示
 struct Item {
-    Production production;  // 对应的产生式
+    int production;         // 产生式编号
     int dot_position;       // 点的位置
     
     bool operator==(const Item& other) const {
         return production == other.production && dot_position == other.dot_position;
     }
     bool operator<(const Item& other) const {
-        if (!(production == other.production)) return production < other.production;
+        if (production != other.production) return production < other.production;
         return dot_position < other.dot_position;
     }
 };
 
 // 表示项集
 struct ItemSet {
-    std::set<Item> items;
-    std::map<std::string, int> goto_transitions;  // 转移函数：符号 -> 项集编号
+    std::vector<Item> items;  // 闭包中的全部项，按产生式（左部, 右部）的字典序和点的位置排列
+    std::vector<std::pair<int, int>> goto_transitions;  // 转移函数：(符号编号, 项集编号)，按符号名排列
     
     bool operator==(const ItemSet& other) const {
         return items == other.items;
     }
 };
 
+// 以核心项的整数编码为键的哈希
+struct KernelHash {
+    size_t operator()(const std::vector<int>& kernel) const {
+        size_t hash = kernel.size();
+        for (int code : kernel) {
+            hash = hash * 1000003 ^ (size_t)code;
+        }
+        return hash;
+    }
+};
+
 // SLR(1)分析表中的操作类型
 enum ActionType {
     SHIFT,
@@ -0,0 +1,80 @@
+#include "parsetable.hpp"
+
+#include <algorithm>
+
+void ParseTable::build(const std::vector<std::vector<ActionEntry>>& action_table,
+                       const std::vector<std::vector<int>>& goto_table, bool compress) {
+    int states = action_table.size();
+    terminals = states ? action_table[0].size() : 0;
+    width = terminals + (states ? goto_table[0].size() : 0);
+    compressed = compress;
+
+    // 每行的非空表项 (列, 值)
+    std::vector<std::vector<std::pair<int, int>>> rows(states);
+    for (int s = 0; s < states; s++) {
+        for (int t = 0; t < terminals; t++) {
+            const ActionEntry& entry = action_table[s][t];
+            int tag = entry.type == SHIFT ? TAG_SHIFT : entry.type == REDUCE ? TAG_REDUCE : entry.type == ACCEPT ? TAG_ACCEPT : 0;
+            if (tag) {
+                rows[s].push_back({t, entry.value << 2 | tag});
+            }
+        }
+        for (size_t n = 0; n < goto_table[s].size(); n++) {
+            if (goto_table[s][n] >= 0) {
+                rows[s].push_back({terminals + (int)n, goto_table[s][n] + 1});
+            }
+        }
+    }
+
+    dense.clear();
+    base.clear();
+    entries.clear();
+    if (!compressed) {
+        dense.assign((size_t)states * width, 0);
+        for (int s = 0; s < states; s++) {
+            for (const auto& [col, value] : rows[s]) {
+                dense[(size_t)s * width + col] = value;
+            }
+        }
+        return;
+    }
+
+    // 行位移压缩：表项多的行先放，每行取第一个与已放表项不冲突的基址
+    std::vector<int> order(states);
+    for (int s = 0; s < states; s++) {
+        order[s] = s;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return rows[a].size() > rows[b].size();
+    });
+    base.assign(states, 0);
+    std::vector<bool> used;
+    for (int s : order) {
+        int b = 0;
+        while (true) {
+            bool fits = true;
+            for (const auto& entry : rows[s]) {
+                size_t i = b + entry.first;
+                if (i < used.size() && used[i]) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) break;
+            b++;
+        }
+        base[s] = b;
+        for (const auto& [col, value] : rows[s]) {
+            size_t i = b + col;
+            if (i >= used.size()) {
+                used.resize(i + 1, false);
+                entries.resize(i + 1, Entry{-1, 0});
+            }
+            used[i] = true;
+            entries[i] = Entry{s, value};
+        }
+    }
+    // 保证任意 基址 + 列号 都不越界
+    int max_base = states ? *std::max_element(base.begin(), base.end()) : 0;
+    entries.resize(std::max(entries.size(), (size_t)max_base + width), Entry{-1, 0});
+}
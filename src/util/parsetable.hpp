@@ -0,0 +1,92 @@
+#ifndef PARSETABLE_HPP
+#define PARSETABLE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "parserule.hpp"
+
+/// @brief 语法分析驱动使用的扁平分析表
+/// ACTION表和GOTO表合为一张按 (状态, 符号编号) 索引的整数表：终结符列存放编码后的动作，
+/// 非终结符列存放转移到的状态加一，0 均表示出错（无转移）。
+/// 稠密模式下每次查表只访问一个表项；压缩模式采用行位移（comb）压缩，
+/// 每行只保存非空表项，查表访问行基址和一个 (检查, 值) 表项，最多两条缓存行
+class ParseTable {
+private:
+    /// @brief 压缩模式下的表项
+    struct Entry {
+        /// @brief 表项所属的状态，-1 表示空位
+        int check;
+        /// @brief 表项的值
+        int value;
+    };
+
+    /// @brief 动作编码的低两位
+    enum Tag {
+        TAG_SHIFT = 1,
+        TAG_REDUCE = 2,
+        TAG_ACCEPT = 3
+    };
+
+    /// @brief 是否为行位移压缩模式
+    bool compressed{false};
+    /// @brief 每行的列数，即符号个数
+    int width{0};
+    /// @brief 终结符个数
+    int terminals{0};
+    /// @brief 稠密表，下标为 状态 * width + 符号编号
+    std::vector<int> dense;
+    /// @brief 压缩模式下每个状态的行基址
+    std::vector<int> base;
+    /// @brief 压缩模式下所有行叠放在一起的表项
+    std::vector<Entry> entries;
+
+    /// @brief 查表
+    /// @param state 状态编号
+    /// @param symbol 符号编号
+    /// @return 表项的值，0 表示空
+    int at(int state, int symbol) const {
+        if (!compressed) {
+            return dense[state * width + symbol];
+        }
+        const Entry& entry = entries[base[state] + symbol];
+        return entry.check == state ? entry.value : 0;
+    }
+
+public:
+    /// @brief 由ACTION表和GOTO表构建
+    /// @param action_table ACTION表，列号为终结符编号
+    /// @param goto_table GOTO表，列号为非终结符编号减去终结符个数，-1表示无转移
+    /// @param compress 是否使用行位移压缩
+    void build(const std::vector<std::vector<ActionEntry>>& action_table,
+               const std::vector<std::vector<int>>& goto_table, bool compress);
+
+    /// @brief 查ACTION表
+    /// @param state 状态编号
+    /// @param terminal 终结符编号
+    /// @return
+    ActionEntry action(int state, int terminal) const {
+        int code = at(state, terminal);
+        switch (code & 3) {
+        case TAG_SHIFT: return ActionEntry(SHIFT, code >> 2);
+        case TAG_REDUCE: return ActionEntry(REDUCE, code >> 2);
+        case TAG_ACCEPT: return ActionEntry(ACCEPT, code >> 2);
+        default: return ActionEntry();
+        }
+    }
+
+    /// @brief 查GOTO表
+    /// @param state 状态编号
+    /// @param non_terminal 非终结符编号
+    /// @return 转移到的状态，-1表示无转移
+    int go(int state, int non_terminal) const {
+        return at(state, non_terminal) - 1;
+    }
+
+    /// @brief 表占用的整数个数
+    /// @return
+    size_t size() const {
+        return compressed ? base.size() + entries.size() * 2 : dense.size();
+    }
+};
+
+#endif
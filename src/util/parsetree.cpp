@@ -1,51 +1,109 @@
 #include "parsetree.hpp"
 #include <iostream>
+#include <string_view>
 
-/// @brief 打印解析树
+/// @brief 打印解析树，用显式栈代替递归
+/// @param vocab 符号编号表
 /// @param depth 缩进
-void ParseTreeNode::print(int depth) const {
-    std::string indent(depth * 2, ' ');
-    if (is_terminal) {
-        std::cout << indent << symbol;
-        if (!token_value.empty() && token_value != symbol) {
-            std::cout << " (" << token_value << ")";
-        }
-        std::cout << std::endl;
-    } else {
-        std::cout << indent << symbol << " ->" << std::endl;
-        for (ParseTreeNode* child : children) {
-            child->print(depth + 1);
+void ParseTreeNode::print(const Vocabulary& vocab, int depth) const {
+    std::vector<std::pair<const ParseTreeNode*, int>> stack{{this, depth}};
+    while (!stack.empty()) {
+        auto [node, level] = stack.back();
+        stack.pop_back();
+        const std::string& name = vocab.name(node->symbol);
+        std::string indent(level * 2, ' ');
+        if (node->is_terminal) {
+            std::cout << indent << name;
+            if (!node->token_value.empty() && node->token_value != name) {
+                std::cout << " (" << node->token_value << ")";
+            }
+            std::cout << std::endl;
+        } else {
+            std::cout << indent << name << " ->" << std::endl;
+            for (size_t i = node->children.size(); i > 0; i--) {
+                stack.push_back({node->children[i - 1], level + 1});
+            }
         }
     }
 }
 
-/// @brief 转换为JSON字符串
-/// @param depth 缩进深度
-/// @return 
-std::string ParseTreeNode::toJSON(int depth) const {
-    std::string indent(depth * 2, ' ');
-    std::string result = indent + "{\n";
-    result += indent + "  \"symbol\": \"" + symbol + "\",\n";
-    result += indent + "  \"is_terminal\": " + (is_terminal ? "true" : "false") + ",\n";
-    
-    if (is_terminal && !token_value.empty()) {
-        result += indent + "  \"value\": \"" + token_value + "\",\n";
+/// @brief JSON输出的缓冲区，攒满一块后整块写出
+struct JSONSink {
+    std::ostream& out;
+    std::string buffer;
+
+    static constexpr size_t FLUSH_SIZE = 1 << 16;
+
+    void indent(int depth) {
+        buffer.append(depth * 2, ' ');
     }
-    
-    if (!children.empty()) {
-        result += indent + "  \"children\": [\n";
-        for (size_t i = 0; i < children.size(); i++) {
-            result += children[i]->toJSON(depth + 2);
-            if (i < children.size() - 1) {
-                result += ",";
-            }
-            result += "\n";
+
+    void put(std::string_view text) {
+        buffer.append(text);
+        if (buffer.size() >= FLUSH_SIZE) flush();
+    }
+
+    void flush() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+};
+
+/// @brief 输出结点的开头直到子结点列表的左括号（没有子结点时输出空列表）
+static void openJSON(JSONSink& sink, const ParseTreeNode* node, const Vocabulary& vocab, int depth) {
+    sink.indent(depth);
+    sink.put("{\n");
+    sink.indent(depth);
+    sink.put("  \"symbol\": \"");
+    sink.put(vocab.name(node->symbol));
+    sink.put("\",\n");
+    sink.indent(depth);
+    sink.put(node->is_terminal ? "  \"is_terminal\": true,\n" : "  \"is_terminal\": false,\n");
+    if (node->is_terminal && !node->token_value.empty()) {
+        sink.indent(depth);
+        sink.put("  \"value\": \"");
+        sink.put(node->token_value);
+        sink.put("\",\n");
+    }
+    sink.indent(depth);
+    sink.put(node->children.empty() ? "  \"children\": []\n" : "  \"children\": [\n");
+}
+
+/// @brief 以JSON格式写出解析树
+/// 用显式栈代替递归，文本直接追加到输出缓冲区，不构造中间字符串
+/// @param out 输出流
+/// @param vocab 符号编号表
+void ParseTreeNode::writeJSON(std::ostream& out, const Vocabulary& vocab) const {
+    struct Frame {
+        const ParseTreeNode* node;
+        int depth;
+        size_t next;
+    };
+    JSONSink sink{out, std::string()};
+    std::vector<Frame> stack;
+    openJSON(sink, this, vocab, 0);
+    stack.push_back(Frame{this, 0, 0});
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        if (frame.next < frame.node->children.size()) {
+            // 子结点比父结点多缩进两层
+            const ParseTreeNode* child = frame.node->children[frame.next++];
+            int depth = frame.depth + 2;
+            openJSON(sink, child, vocab, depth);
+            stack.push_back(Frame{child, depth, 0});
+            continue;
+        }
+        if (!frame.node->children.empty()) {
+            sink.indent(frame.depth);
+            sink.put("  ]\n");
+        }
+        sink.indent(frame.depth);
+        sink.put("}");
+        stack.pop_back();
+        if (!stack.empty()) {
+            const Frame& parent = stack.back();
+            sink.put(parent.next < parent.node->children.size() ? ",\n" : "\n");
         }
-        result += indent + "  ]\n";
-    } else {
-        result += indent + "  \"children\": []\n";
     }
-    
-    result += indent + "}";
-    return result;
+    sink.flush();
 }
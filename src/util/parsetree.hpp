@@ -1,49 +1,80 @@
 #ifndef PARSETREE_HPP
 #define PARSETREE_HPP
 
-#include <vector>
+#include <algorithm>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include "arena.hpp"
+#include "parserule.hpp"
 #include "token.hpp"
+#include "vocabulary.hpp"
 
 /// @brief 解析树结点
+/// 结点和子结点数组都分配在语法分析器的内存池中，随内存池整体释放，不逐个析构
 struct ParseTreeNode {
-    /// @brief 符号名称
-    std::string symbol;
+    /// @brief 符号编号
+    int symbol;
     /// @brief 是否为终结符
     bool is_terminal;      
-    /// @brief 子节点
-    std::vector<ParseTreeNode*> children;
-    /// @brief 如果是终结符，存储token值
-    std::string token_value;
+    /// @brief 非终结符归约所用的产生式编号，终结符为-1
+    int production;
+    /// @brief 子节点，数组位于内存池中
+    ArenaArray<ParseTreeNode*> children;
+    /// @brief 如果是终结符，存储token值，指向源程序缓冲区
+    std::string_view token_value;
     /// @brief 对应的token
     Token start;
     Token end;
 
     /// @brief 构造函数 
-    /// @param sym 符号名称
+    /// @param sym 符号编号
     /// @param is_term 是否终结符
     /// @param value token值
-    ParseTreeNode(const std::string& sym, Token start, Token end) 
-        : symbol(sym), is_terminal(false), token_value(""), start(start), end(end) {}
+    ParseTreeNode(int sym, Token start, Token end, int prod = -1) 
+        : symbol(sym), is_terminal(false), production(prod), token_value(""), start(start), end(end) {}
 
-    ParseTreeNode(const std::string& sym, Token terminal) 
-        : symbol(sym), is_terminal(true), token_value(terminal.getValue()), start(terminal), end(terminal) {}
+    ParseTreeNode(int sym, Token terminal) 
+        : symbol(sym), is_terminal(true), production(-1), token_value(terminal.getValue()), start(terminal), end(terminal) {}
 
-    /// @brief 析构函数
-    ~ParseTreeNode() {
-        for (ParseTreeNode* child : children) {
-            delete child;
-        }
-    }
-    
     /// @brief 打印解析树
+    /// @param vocab 符号编号表
     /// @param depth 缩进
-    void print(int depth = 0) const;
+    void print(const Vocabulary& vocab, int depth = 0) const;
     
-    /// @brief 转换为JSON字符串
-    /// @param depth 缩进深度
-    /// @return 
-    std::string toJSON(int depth = 0) const;
+    /// @brief 以JSON格式写出解析树，不递归，也不构造中间字符串
+    /// @param out 输出流
+    /// @param vocab 符号编号表
+    void writeJSON(std::ostream& out, const Vocabulary& vocab) const;
+};
+
+/// @brief 构造解析树的语义动作，语义值为解析树结点，结点分配在内存池中
+struct TreeActions {
+    using Value = ParseTreeNode*;
+
+    Arena& arena;
+
+    Value shift(const Token& token) {
+        return arena.create<ParseTreeNode>(token.getKind(), token);
+    }
+
+    Value reduce(const Production& prod, Value* rhs) {
+        int count = prod.rhs.size();
+        if (count == 0) {
+            // 对于空产生式，创建一个ε节点
+            return arena.create<ParseTreeNode>(prod.lhs, Token(), Token(), prod.id);
+        }
+        ParseTreeNode* node = arena.create<ParseTreeNode>(prod.lhs, rhs[0]->start, rhs[count - 1]->end, prod.id);
+        node->children.items = arena.allocateArray<ParseTreeNode*>(count);
+        node->children.count = count;
+        std::copy(rhs, rhs + count, node->children.items);
+        return node;
+    }
+
+    /// @brief 结点随内存池整体释放
+    void discard(Value& value) {
+        value = nullptr;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "source.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceBuffer::SourceBuffer(void* mapping, size_t size)
+    : mapping(mapping), mappingSize(size),
+      data(static_cast<const char*>(mapping), size), lineIndex(data) {}
+
+SourceBuffer::~SourceBuffer() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+}
+
+std::unique_ptr<SourceBuffer> SourceBuffer::load(const std::string& filename) {
+    bool isStdin = filename == "-";
+    int fd = isStdin ? STDIN_FILENO : open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    // 普通文件直接映射，映射建立后即可关闭文件描述符
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+            if (!isStdin) {
+                close(fd);
+            }
+            return std::unique_ptr<SourceBuffer>(new SourceBuffer(mapping, st.st_size));
+        }
+    }
+
+    // 管道、标准输入、空文件等无法映射的输入缓冲读入
+    std::string text;
+    char buf[1 << 16];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) != 0) {
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (!isStdin) {
+                close(fd);
+            }
+            return nullptr;
+        }
+        text.append(buf, n);
+    }
+    if (!isStdin) {
+        close(fd);
+    }
+    return std::make_unique<SourceBuffer>(std::move(text));
+}
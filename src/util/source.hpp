@@ -0,0 +1,118 @@
+#ifndef SOURCE_HPP
+#define SOURCE_HPP
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// @brief 行首偏移索引，将字节偏移转换为行列号
+/// 行首表在第一次查询时才建立，没有诊断或输出需要位置时不产生任何开销
+class LineIndex {
+private:
+    /// @brief 源程序文本
+    std::string_view text;
+    /// @brief 每一行第一个字符的偏移
+    mutable std::vector<size_t> lineStarts;
+
+public:
+    /// @brief 构造函数
+    /// @param text 源程序文本
+    explicit LineIndex(std::string_view text) : text(text) {}
+
+    /// @brief 将偏移转换为行列号（均从1开始）
+    /// @param offset 字节偏移
+    /// @return (行号, 列号)
+    std::pair<size_t, size_t> lineCol(size_t offset) const {
+        if (lineStarts.empty()) {
+            lineStarts.push_back(0);
+            for (size_t i = 0; i < text.size(); i++) {
+                if (text[i] == '\n') {
+                    lineStarts.push_back(i + 1);
+                }
+            }
+        }
+        auto it = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - 1;
+        return std::make_pair(it - lineStarts.begin() + 1, offset - *it + 1);
+    }
+};
+
+/// @brief 源程序中的位置，只记录偏移，行列号在需要时才计算
+struct SourcePos {
+    /// @brief 所属源程序的行首索引，为空表示没有位置（行列号均为0）
+    const LineIndex* lines{nullptr};
+    /// @brief 字节偏移
+    size_t offset{0};
+
+    /// @brief 获取行号
+    /// @return 
+    size_t line() const {
+        return lines ? lines->lineCol(offset).first : 0;
+    }
+
+    /// @brief 获取列号
+    /// @return 
+    size_t col() const {
+        return lines ? lines->lineCol(offset).second : 0;
+    }
+};
+
+/// @brief 源程序缓冲区，在整个编译过程中持有源程序文本，token只保存指向其中的视图
+/// 普通文件以只读方式映射到内存，不经过任何复制；管道和标准输入则缓冲读入
+class SourceBuffer {
+private:
+    /// @brief 缓冲读入时持有的源程序文本
+    std::string text;
+    /// @brief 文件映射的起始地址，为空表示未使用映射
+    void* mapping{nullptr};
+    /// @brief 文件映射的长度
+    size_t mappingSize{0};
+    /// @brief 源程序文本的视图，指向 text 或文件映射
+    std::string_view data;
+    /// @brief 行首索引
+    LineIndex lineIndex;
+
+    /// @brief 由文件映射构造
+    /// @param mapping 映射起始地址
+    /// @param size 映射长度
+    SourceBuffer(void* mapping, size_t size);
+
+public:
+    /// @brief 构造函数
+    /// @param text 源程序文本
+    explicit SourceBuffer(std::string text)
+        : text(std::move(text)), data(this->text), lineIndex(data) {}
+
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    /// @brief 读入源文件：普通文件映射到内存，管道等无法映射的输入缓冲读入
+    /// @param filename 文件名，"-" 表示标准输入
+    /// @return 源程序缓冲区，无法读取时返回空指针
+    static std::unique_ptr<SourceBuffer> load(const std::string& filename);
+
+    /// @brief 获取源程序文本的视图
+    /// @return 
+    std::string_view view() const {
+        return data;
+    }
+
+    /// @brief 获取行首索引
+    /// @return 
+    const LineIndex& lines() const {
+        return lineIndex;
+    }
+
+    /// @brief 获取偏移对应的位置
+    /// @param offset 字节偏移
+    /// @return 
+    SourcePos pos(size_t offset) const {
+        return SourcePos{&lineIndex, offset};
+    }
+};
+
+#endif
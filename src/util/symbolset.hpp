@@ -0,0 +1,58 @@
+#ifndef SYMBOLSET_HPP
+#define SYMBOLSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief 以符号编号为下标的稠密位集合，用于FIRST/FOLLOW集合
+/// 并集按64位字进行，遍历按编号从小到大，与按符号名排列的顺序一致（符号按名字顺序编号）
+class SymbolSet {
+private:
+    std::vector<uint64_t> words;
+
+public:
+    SymbolSet() = default;
+
+    /// @brief 构造空集合
+    /// @param size 符号编号的上界
+    explicit SymbolSet(size_t size) : words((size + 63) / 64, 0) {}
+
+    /// @brief 加入符号
+    /// @param symbol
+    void insert(int symbol) {
+        words[symbol >> 6] |= uint64_t(1) << (symbol & 63);
+    }
+
+    /// @brief 判断符号是否在集合中
+    /// @param symbol
+    /// @return
+    bool contains(int symbol) const {
+        return (words[symbol >> 6] >> (symbol & 63)) & 1;
+    }
+
+    /// @brief 并入另一个同样大小的集合
+    /// @param other
+    /// @return 集合是否改变
+    bool unite(const SymbolSet& other) {
+        uint64_t added = 0;
+        for (size_t i = 0; i < words.size(); i++) {
+            added |= other.words[i] & ~words[i];
+            words[i] |= other.words[i];
+        }
+        return added != 0;
+    }
+
+    /// @brief 按编号从小到大访问集合中的符号
+    /// @param visit
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (size_t i = 0; i < words.size(); i++) {
+            for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+                visit(int(i * 64 + __builtin_ctzll(word)));
+            }
+        }
+    }
+};
+
+#endif
@@ -2,63 +2,70 @@
 #define TOKEN_HPP
 
 #include <string>
+#include <string_view>
+#include "source.hpp"
+#include "vocabulary.hpp"
 
 /// @brief 词法单元
 class Token {
 private:
-    /// @brief 源程序的位置
-    size_t position[4];
-    /// @brief 词法单元记号
-    std::string id;
-    /// @brief 对应的字符串
-    std::string value;
+    /// @brief 在源程序中的开始位置
+    SourcePos start;
+    /// @brief 在源程序中的结束位置
+    SourcePos end;
+    /// @brief 词法单元记号的编号，-1表示没有记号
+    int kind;
+    /// @brief 对应的字符串，指向源程序缓冲区
+    std::string_view value;
 
 public:
     /// @brief 构造函数
     Token() {
-        this->position[0] = 0;
-        this->position[1] = 0;
-        this->position[2] = 0;
-        this->position[3] = 0;
-        this->id = "";
+        this->kind = -1;
         this->value = "";
     }
 
     /// @brief 构造函数 
-    /// @param position 位置
-    /// @param id 记号
-    /// @param value 字符串
-    Token(size_t position[], std::string id, std::string value) {
-        this->position[0] = position[0];
-        this->position[1] = position[1];
-        this->position[2] = position[2];
-        this->position[3] = position[3];
-        this->id = id;
+    /// @param start 开始位置
+    /// @param end 结束位置
+    /// @param kind 记号编号
+    /// @param value 字符串，须在源程序缓冲区的生命周期内有效
+    Token(SourcePos start, SourcePos end, int kind, std::string_view value) {
+        this->start = start;
+        this->end = end;
+        this->kind = kind;
         this->value = value;
     }
 
     /// @brief 转换为字符串
+    /// @param vocab 符号编号表
     /// @return 
-    std::string toString() {
-        return "(" + id + ", " + value + ")";
+    std::string toString(const Vocabulary& vocab) const {
+        return "(" + vocab.name(kind) + ", " + std::string(value) + ")";
     }
 
-    /// @brief 获取记号
+    /// @brief 获取记号编号
     /// @return 
-    std::string getId() {
-        return id;
+    int getKind() const {
+        return kind;
     }
 
     /// @brief 获取实际值
     /// @return 
-    std::string getValue() {
+    std::string_view getValue() const {
         return value;
     }
 
-    /// @brief 获取位置
+    /// @brief 获取开始位置
     /// @return 
-    size_t* getPos() {
-        return position;
+    SourcePos getStart() const {
+        return start;
+    }
+
+    /// @brief 获取结束位置
+    /// @return 
+    SourcePos getEnd() const {
+        return end;
     }
 };
 
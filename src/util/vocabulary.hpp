@@ -0,0 +1,53 @@
+#ifndef VOCABULARY_HPP
+#define VOCABULARY_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief 文法符号编号表
+/// 终结符、非终结符以及只出现在词法规则中的记号统一编号，
+/// 分析过程中只使用编号，名称仅用于输出
+class Vocabulary {
+private:
+    /// @brief 编号 -> 名称
+    std::vector<std::string> names;
+    /// @brief 名称 -> 编号
+    std::unordered_map<std::string, int> ids;
+
+public:
+    /// @brief 获取符号编号，不存在时分配新编号
+    /// @param name 符号名称
+    /// @return 符号编号
+    int intern(const std::string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        int id = names.size();
+        ids.emplace(name, id);
+        names.push_back(name);
+        return id;
+    }
+
+    /// @brief 查找符号编号
+    /// @param name 符号名称
+    /// @return 符号编号，不存在时返回-1
+    int find(const std::string& name) const {
+        auto it = ids.find(name);
+        return it == ids.end() ? -1 : it->second;
+    }
+
+    /// @brief 获取符号名称
+    /// @param id 符号编号
+    /// @return 符号名称
+    const std::string& name(int id) const {
+        return names[id];
+    }
+
+    /// @brief 符号个数
+    /// @return 
+    size_t size() const {
+        return names.size();
+    }
+};
+
+#endif